@@ -60,12 +60,38 @@ __median(const _Tp& __a, const _Tp& __b, const _Tp& __c, _Compare __comp) {
 //ºfӦ[first,last)ڵÿһԪ
 //עܸı[first,last)Ԫֵ
 template <class _InputIter, class _Function>
-_Function for_each(_InputIter __first, _InputIter __last, _Function __f) {
-  __STL_REQUIRES(_InputIter, _InputIterator);
+inline _Function __for_each_aux(_InputIter __first, _InputIter __last,
+                                _Function __f, __false_type) {
   for ( ; __first != __last; ++__first)
     __f(*__first);//÷ºf
   return __f;
 }
+
+//ֶ(deque)ָ
+template <class _SegIter, class _Function>
+_Function __for_each_aux(_SegIter __first, _SegIter __last,
+                         _Function __f, __true_type) {
+  typedef __segmented_traits<_SegIter> _Traits;
+  typename _Traits::_Segment __sfirst = _Traits::_S_segment(__first);
+  typename _Traits::_Segment __slast = _Traits::_S_segment(__last);
+  if (__sfirst == __slast)
+    return __for_each_aux(_Traits::_S_local(__first),
+                          _Traits::_S_local(__last), __f, __false_type());
+  __f = __for_each_aux(_Traits::_S_local(__first), _Traits::_S_end(__sfirst),
+                       __f, __false_type());
+  for (++__sfirst; __sfirst != __slast; ++__sfirst)
+    __f = __for_each_aux(_Traits::_S_begin(__sfirst),
+                         _Traits::_S_end(__sfirst), __f, __false_type());
+  return __for_each_aux(_Traits::_S_begin(__slast), _Traits::_S_local(__last),
+                        __f, __false_type());
+}
+
+template <class _InputIter, class _Function>
+_Function for_each(_InputIter __first, _InputIter __last, _Function __f) {
+  __STL_REQUIRES(_InputIter, _InputIterator);
+  typedef typename __segmented_traits<_InputIter>::_Is_segmented _Segmented;
+  return __for_each_aux(__first, __last, __f, _Segmented());
+}
 //for_each
 /*
 	#include <iostream>     // std::cout
@@ -211,6 +237,72 @@ _RandomAccessIter find_if(_RandomAccessIter __first, _RandomAccessIter __last,
 }
 
 #endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
+//ȡfirstͣݵ͵òͬĺ
+template <class _InputIter, class _Tp>
+inline _InputIter __find_aux(_InputIter __first, _InputIter __last,
+                             const _Tp& __val, __false_type)
+{
+  return find(__first, __last, __val, __ITERATOR_CATEGORY(__first));
+}
+
+// A segmented range (a deque; see __segmented_traits in stl_algobase.h)
+// is searched one segment at a time, each as a pointer range.
+template <class _SegIter, class _Tp>
+_SegIter __find_aux(_SegIter __first, _SegIter __last,
+                    const _Tp& __val, __true_type)
+{
+  typedef __segmented_traits<_SegIter> _Traits;
+  typedef typename _Traits::_Local _Local;
+  typename _Traits::_Segment __seg = _Traits::_S_segment(__first);
+  typename _Traits::_Segment __slast = _Traits::_S_segment(__last);
+  _Local __cur = _Traits::_S_local(__first);
+  typename iterator_traits<_SegIter>::difference_type __skipped = 0;//ѲԪظ
+  for (;;) {
+    _Local __end = __seg == __slast ? _Traits::_S_local(__last)
+                                    : _Traits::_S_end(__seg);
+    _Local __pos = find(__cur, __end, __val, __ITERATOR_CATEGORY(__cur));
+    if (__pos != __end)
+      return __first + (__skipped + (__pos - __cur));
+    if (__seg == __slast)
+      return __last;
+    __skipped += __end - __cur;
+    ++__seg;
+    __cur = _Traits::_S_begin(__seg);
+  }
+}
+
+template <class _InputIter, class _Predicate>
+inline _InputIter __find_if_aux(_InputIter __first, _InputIter __last,
+                                _Predicate __pred, __false_type)
+{
+  return find_if(__first, __last, __pred, __ITERATOR_CATEGORY(__first));
+}
+
+template <class _SegIter, class _Predicate>
+_SegIter __find_if_aux(_SegIter __first, _SegIter __last,
+                       _Predicate __pred, __true_type)
+{
+  typedef __segmented_traits<_SegIter> _Traits;
+  typedef typename _Traits::_Local _Local;
+  typename _Traits::_Segment __seg = _Traits::_S_segment(__first);
+  typename _Traits::_Segment __slast = _Traits::_S_segment(__last);
+  _Local __cur = _Traits::_S_local(__first);
+  typename iterator_traits<_SegIter>::difference_type __skipped = 0;
+  for (;;) {
+    _Local __end = __seg == __slast ? _Traits::_S_local(__last)
+                                    : _Traits::_S_end(__seg);
+    _Local __pos = find_if(__cur, __end, __pred, __ITERATOR_CATEGORY(__cur));
+    if (__pos != __end)
+      return __first + (__skipped + (__pos - __cur));
+    if (__seg == __slast)
+      return __last;
+    __skipped += __end - __cur;
+    ++__seg;
+    __cur = _Traits::_S_begin(__seg);
+  }
+}
+
 /*findܣReturns an iterator to the first element in the range [first,last) that compares equal to val. 
 If no such element is found, the function returns last.
 findԭͣ
@@ -225,8 +317,8 @@ inline _InputIter find(_InputIter __first, _InputIter __last,
   __STL_REQUIRES(_InputIter, _InputIterator);
   __STL_REQUIRES_BINARY_OP(_OP_EQUAL, bool, 
             typename iterator_traits<_InputIter>::value_type, _Tp);
-  //ȡfirstͣݵ͵òͬĺ
-  return find(__first, __last, __val, __ITERATOR_CATEGORY(__first));
+  typedef typename __segmented_traits<_InputIter>::_Is_segmented _Segmented;
+  return __find_aux(__first, __last, __val, _Segmented());
 }
 /*find_ifܣReturns an iterator to the first element in the range [first,last) for which pred returns true. 
 If no such element is found, the function returns last.
@@ -241,8 +333,8 @@ inline _InputIter find_if(_InputIter __first, _InputIter __last,
   __STL_REQUIRES(_InputIter, _InputIterator);
   __STL_UNARY_FUNCTION_CHECK(_Predicate, bool,
           typename iterator_traits<_InputIter>::value_type);
-  //ȡfirstͣݵ͵òͬĺ
-  return find_if(__first, __last, __pred, __ITERATOR_CATEGORY(__first));
+  typedef typename __segmented_traits<_InputIter>::_Is_segmented _Segmented;
+  return __find_if_aux(__first, __last, __pred, _Segmented());
 }
 //findfind_if
 /*
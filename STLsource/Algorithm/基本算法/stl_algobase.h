@@ -118,6 +118,36 @@ inline const _Tp& max(const _Tp& __a, const _Tp& __b, _Compare __comp) {
   return __comp(__a, __b) ? __b : __a;
 }
 
+// operator< as a function object, for versions without __comp that
+// forward to the ones with it.  Unlike less<_Tp>, it does not need
+// <stl_function.h>.
+template <class _Tp>
+struct __less_than {//ڲʹãcompİ汾תcompİ汾
+  bool operator()(const _Tp& __x, const _Tp& __y) const { return __x < __y; }
+};
+
+//--------------------------------------------------
+// Segmented iterators
+
+// Some iterators run over storage made of contiguous segments: deque's
+// iterator walks its buffers one after another, testing for the end of
+// a buffer at every step.  Such an iterator specializes
+// __segmented_traits, and copy, copy_backward, fill, fill_n and
+// lexicographical_compare below (find, for_each and accumulate too)
+// then go through the range one segment at a time, each as a plain
+// pointer range, where memmove, memset and the compiler's vectorizer
+// apply.  A specialization defines
+//   _Is_segmented              __true_type
+//   _Segment                   a segment; ++ and -- step to the next one
+//   _Local                     a pointer into a segment
+//   _S_segment(__i)            the segment __i is in
+//   _S_local(__i)              where __i is in that segment
+//   _S_begin(__s), _S_end(__s) the bounds of segment __s
+template <class _Iter>
+struct __segmented_traits {
+  typedef __false_type _Is_segmented;
+};
+
 //--------------------------------------------------
 // copy
 
@@ -137,11 +167,10 @@ inline _OutputIter __copy(_InputIter __first, _InputIter __last,
     *__result = *__first;//һһĸֵoperator=
   return __result;
 }
-//Ϊʵô˺
 template <class _RandomAccessIter, class _OutputIter, class _Distance>
 inline _OutputIter
-__copy(_RandomAccessIter __first, _RandomAccessIter __last,
-       _OutputIter __result, random_access_iterator_tag, _Distance*)
+__copy_segmented(_RandomAccessIter __first, _RandomAccessIter __last,
+                 _OutputIter __result, __false_type, __false_type, _Distance*)
 {
   for (_Distance __n = __last - __first; __n > 0; --__n) {//
     *__result = *__first;//Ӧֵoperator=
@@ -151,6 +180,30 @@ __copy(_RandomAccessIter __first, _RandomAccessIter __last,
   return __result;
 }
 
+// Defined after copy, which they call on each segment.
+template <class _SegIter, class _OutputIter, class _Seg_out, class _Distance>
+_OutputIter __copy_segmented(_SegIter __first, _SegIter __last,
+                             _OutputIter __result,
+                             __true_type, _Seg_out, _Distance*);
+template <class _RandomAccessIter, class _SegIter, class _Distance>
+_SegIter __copy_segmented(_RandomAccessIter __first, _RandomAccessIter __last,
+                          _SegIter __result,
+                          __false_type, __true_type, _Distance*);
+
+//Ϊʵô˺
+//Ƿֶ(deque)θ
+template <class _RandomAccessIter, class _OutputIter, class _Distance>
+inline _OutputIter
+__copy(_RandomAccessIter __first, _RandomAccessIter __last,
+       _OutputIter __result, random_access_iterator_tag, _Distance*)
+{
+  typedef typename __segmented_traits<_RandomAccessIter>::_Is_segmented
+          _Seg_in;
+  typedef typename __segmented_traits<_OutputIter>::_Is_segmented _Seg_out;
+  return __copy_segmented(__first, __last, __result,
+                          _Seg_in(), _Seg_out(), (_Distance*) 0);
+}
+
 //ֱӵmemmoveƣҪ
 template <class _Tp>
 inline _Tp*
@@ -342,6 +395,54 @@ __SGI_STL_DECLARE_COPY_TRIVIAL(long double)
 #undef __SGI_STL_DECLARE_COPY_TRIVIAL
 #endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
 
+// Segment-wise copy.  The inner copy calls see plain pointers on the
+// segmented side, so they reach memmove whenever the value type allows.
+
+//ֶθ
+template <class _SegIter, class _OutputIter, class _Seg_out, class _Distance>
+_OutputIter __copy_segmented(_SegIter __first, _SegIter __last,
+                             _OutputIter __result,
+                             __true_type, _Seg_out, _Distance*)
+{
+  typedef __segmented_traits<_SegIter> _Traits;
+  typename _Traits::_Segment __sfirst = _Traits::_S_segment(__first);
+  typename _Traits::_Segment __slast = _Traits::_S_segment(__last);
+  if (__sfirst == __slast)
+    return copy(_Traits::_S_local(__first), _Traits::_S_local(__last),
+                __result);
+  __result = copy(_Traits::_S_local(__first), _Traits::_S_end(__sfirst),
+                  __result);
+  for (++__sfirst; __sfirst != __slast; ++__sfirst)
+    __result = copy(_Traits::_S_begin(__sfirst), _Traits::_S_end(__sfirst),
+                    __result);
+  return copy(_Traits::_S_begin(__slast), _Traits::_S_local(__last),
+              __result);
+}
+
+//ֶֻεʣռп鸴
+template <class _RandomAccessIter, class _SegIter, class _Distance>
+_SegIter __copy_segmented(_RandomAccessIter __first, _RandomAccessIter __last,
+                          _SegIter __result,
+                          __false_type, __true_type, _Distance*)
+{
+  typedef __segmented_traits<_SegIter> _Traits;
+  typename _Traits::_Segment __seg = _Traits::_S_segment(__result);
+  typename _Traits::_Local __cur = _Traits::_S_local(__result);
+  const _Distance __len = __last - __first;
+  for (_Distance __n = __len; __n > 0; ) {
+    _Distance __room = _Traits::_S_end(__seg) - __cur;
+    _Distance __k = __n < __room ? __n : __room;
+    copy(__first, __first + __k, __cur);
+    __first += __k;
+    __n -= __k;
+    if (__n > 0) {
+      ++__seg;
+      __cur = _Traits::_S_begin(__seg);
+    }
+  }
+  return __result + __len;
+}
+
 //--------------------------------------------------
 // copy_backward
 /*ԭ
@@ -364,6 +465,30 @@ inline _BidirectionalIter2 __copy_backward(_BidirectionalIter1 __first,
     *--__result = *--__last;//ֵoperator=
   return __result;
 }
+template <class _RandomAccessIter, class _BidirectionalIter, class _Distance>
+inline _BidirectionalIter
+__copy_backward_segmented(_RandomAccessIter __first, _RandomAccessIter __last,
+                          _BidirectionalIter __result,
+                          __false_type, __false_type, _Distance*)
+{
+  for (_Distance __n = __last - __first; __n > 0; --__n)//
+    *--__result = *--__last;//ֵoperator=
+  return __result;
+}
+
+// Defined after copy_backward, as for copy.
+template <class _SegIter, class _BidirectionalIter, class _Seg_out,
+          class _Distance>
+_BidirectionalIter
+__copy_backward_segmented(_SegIter __first, _SegIter __last,
+                          _BidirectionalIter __result,
+                          __true_type, _Seg_out, _Distance*);
+template <class _RandomAccessIter, class _SegIter, class _Distance>
+_SegIter
+__copy_backward_segmented(_RandomAccessIter __first, _RandomAccessIter __last,
+                          _SegIter __result,
+                          __false_type, __true_type, _Distance*);
+
 //ʵĵ
 template <class _RandomAccessIter, class _BidirectionalIter, class _Distance>
 inline _BidirectionalIter __copy_backward(_RandomAccessIter __first, 
@@ -372,9 +497,12 @@ inline _BidirectionalIter __copy_backward(_RandomAccessIter __first,
                                           random_access_iterator_tag,
                                           _Distance*)
 {
-  for (_Distance __n = __last - __first; __n > 0; --__n)//
-    *--__result = *--__last;//ֵoperator=
-  return __result;
+  typedef typename __segmented_traits<_RandomAccessIter>::_Is_segmented
+          _Seg_in;
+  typedef typename __segmented_traits<_BidirectionalIter>::_Is_segmented
+          _Seg_out;
+  return __copy_backward_segmented(__first, __last, __result,
+                                   _Seg_in(), _Seg_out(), (_Distance*) 0);
 }
 
 #ifdef __STL_CLASS_PARTIAL_SPECIALIZATION 
@@ -446,6 +574,55 @@ inline _BI2 copy_backward(_BI1 __first, _BI1 __last, _BI2 __result) {
 
 #endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
 
+//ֶһοʼ
+template <class _SegIter, class _BidirectionalIter, class _Seg_out,
+          class _Distance>
+_BidirectionalIter
+__copy_backward_segmented(_SegIter __first, _SegIter __last,
+                          _BidirectionalIter __result,
+                          __true_type, _Seg_out, _Distance*)
+{
+  typedef __segmented_traits<_SegIter> _Traits;
+  typename _Traits::_Segment __sfirst = _Traits::_S_segment(__first);
+  typename _Traits::_Segment __slast = _Traits::_S_segment(__last);
+  if (__sfirst == __slast)
+    return copy_backward(_Traits::_S_local(__first),
+                         _Traits::_S_local(__last), __result);
+  __result = copy_backward(_Traits::_S_begin(__slast),
+                           _Traits::_S_local(__last), __result);
+  for (--__slast; __slast != __sfirst; --__slast)
+    __result = copy_backward(_Traits::_S_begin(__slast),
+                             _Traits::_S_end(__slast), __result);
+  return copy_backward(_Traits::_S_local(__first), _Traits::_S_end(__sfirst),
+                       __result);
+}
+
+//ֶֻ
+template <class _RandomAccessIter, class _SegIter, class _Distance>
+_SegIter
+__copy_backward_segmented(_RandomAccessIter __first, _RandomAccessIter __last,
+                          _SegIter __result,
+                          __false_type, __true_type, _Distance*)
+{
+  typedef __segmented_traits<_SegIter> _Traits;
+  typename _Traits::_Segment __seg = _Traits::_S_segment(__result);
+  typename _Traits::_Local __cur = _Traits::_S_local(__result);
+  const _Distance __len = __last - __first;
+  for (_Distance __n = __len; __n > 0; ) {
+    _Distance __room = __cur - _Traits::_S_begin(__seg);
+    _Distance __k = __n < __room ? __n : __room;
+    copy_backward(__last - __k, __last, __cur);
+    __last -= __k;
+    __cur -= __k;
+    __n -= __k;
+    if (__n > 0) {
+      --__seg;
+      __cur = _Traits::_S_end(__seg);
+    }
+  }
+  return __result - __len;
+}
+
 //--------------------------------------------------
 // copy_n (not part of the C++ standard)
 /*ԭ
@@ -527,27 +704,60 @@ copy_n(_InputIter __first, _Size __count, _OutputIter __result) {
 	template <class ForwardIterator, class T>
 	void fill (ForwardIterator first, ForwardIterator last, const T& val);
 */
+template <class _ForwardIter, class _Tp>
+inline void __fill_aux(_ForwardIter __first, _ForwardIter __last,
+                       const _Tp& __value, __false_type) {
+  for ( ; __first != __last; ++__first)//
+    *__first = __value;//ǰλøֵvalue
+}
+
+// Defined after the memset overloads of fill below, so that a deque of
+// bytes is filled with memset one buffer at a time.
+template <class _SegIter, class _Tp>
+void __fill_aux(_SegIter __first, _SegIter __last, const _Tp& __value,
+                __true_type);
+
 //[first,last)ֵΪvalue
 template <class _ForwardIter, class _Tp>
 void fill(_ForwardIter __first, _ForwardIter __last, const _Tp& __value) {
   __STL_REQUIRES(_ForwardIter, _Mutable_ForwardIterator);
-  for ( ; __first != __last; ++__first)//
-    *__first = __value;//ǰλøֵvalue
+  typedef typename __segmented_traits<_ForwardIter>::_Is_segmented
+          _Segmented;
+  __fill_aux(__first, __last, __value, _Segmented());
 }
 /*
 ָλnֵAssigns val to the first n elements of the sequence pointed by first.
 	template <class OutputIterator, class Size, class T>
 	void fill_n (OutputIterator first, Size n, const T& val);
 */
-//firstʼnvalueֵ
 template <class _OutputIter, class _Size, class _Tp>
-_OutputIter fill_n(_OutputIter __first, _Size __n, const _Tp& __value) {
-  __STL_REQUIRES(_OutputIter, _OutputIterator);
+inline _OutputIter __fill_n_aux(_OutputIter __first, _Size __n,
+                                const _Tp& __value, __false_type) {
   for ( ; __n > 0; --__n, ++__first)//firstʼnλ
     *__first = __value;//ǰλøֵvalue
   return __first;
 }
 
+//ֶʣβٽfill
+template <class _SegIter, class _Size, class _Tp>
+inline _SegIter __fill_n_aux(_SegIter __first, _Size __n,
+                             const _Tp& __value, __true_type) {
+  if (__n <= 0)
+    return __first;
+  _SegIter __last = __first + __n;
+  fill(__first, __last, __value);
+  return __last;
+}
+
+//firstʼnvalueֵ
+template <class _OutputIter, class _Size, class _Tp>
+_OutputIter fill_n(_OutputIter __first, _Size __n, const _Tp& __value) {
+  __STL_REQUIRES(_OutputIter, _OutputIterator);
+  typedef typename __segmented_traits<_OutputIter>::_Is_segmented
+          _Segmented;
+  return __fill_n_aux(__first, __n, __value, _Segmented());
+}
+
 // Specialization: for one-byte types we can use memset.
 
 inline void fill(unsigned char* __first, unsigned char* __last,
@@ -569,6 +779,24 @@ inline void fill(char* __first, char* __last, const char& __c) {
   memset(__first, static_cast<unsigned char>(__tmp), __last - __first);
 }
 
+//ֶ
+template <class _SegIter, class _Tp>
+void __fill_aux(_SegIter __first, _SegIter __last, const _Tp& __value,
+                __true_type)
+{
+  typedef __segmented_traits<_SegIter> _Traits;
+  typename _Traits::_Segment __sfirst = _Traits::_S_segment(__first);
+  typename _Traits::_Segment __slast = _Traits::_S_segment(__last);
+  if (__sfirst == __slast) {
+    fill(_Traits::_S_local(__first), _Traits::_S_local(__last), __value);
+    return;
+  }
+  fill(_Traits::_S_local(__first), _Traits::_S_end(__sfirst), __value);
+  for (++__sfirst; __sfirst != __slast; ++__sfirst)
+    fill(_Traits::_S_begin(__sfirst), _Traits::_S_end(__sfirst), __value);
+  fill(_Traits::_S_begin(__slast), _Traits::_S_local(__last), __value);
+}
+
 #ifdef __STL_FUNCTION_TMPL_PARTIAL_ORDER
 
 template <class _Size>
@@ -712,16 +940,10 @@ custom (2)
 3ﵽlast1last2(дС)
 */
 
-//汾һĬϱȽϲΪless
 template <class _InputIter1, class _InputIter2>
-bool lexicographical_compare(_InputIter1 __first1, _InputIter1 __last1,
-                             _InputIter2 __first2, _InputIter2 __last2) {
-  __STL_REQUIRES(_InputIter1, _InputIterator);
-  __STL_REQUIRES(_InputIter2, _InputIterator);
-  __STL_REQUIRES(typename iterator_traits<_InputIter1>::value_type,
-                 _LessThanComparable);
-  __STL_REQUIRES(typename iterator_traits<_InputIter2>::value_type,
-                 _LessThanComparable);
+bool __lexicographical_compare_aux(_InputIter1 __first1, _InputIter1 __last1,
+                                   _InputIter2 __first2, _InputIter2 __last2,
+                                   __false_type) {
   //κһеβˣоӦԪؽбȽ
   for ( ; __first1 != __last1 && __first2 != __last2
         ; ++__first1, ++__first2) {
@@ -735,13 +957,53 @@ bool lexicographical_compare(_InputIter1 __first1, _InputIter1 __last1,
   return __first1 == __last1 && __first2 != __last2;
 }
 
-//汾ûָȽϹ
-template <class _InputIter1, class _InputIter2, class _Compare>
+//һзֶָһ
+template <class _SegIter, class _InputIter2>
+bool __lexicographical_compare_aux(_SegIter __first1, _SegIter __last1,
+                                   _InputIter2 __first2, _InputIter2 __last2,
+                                   __true_type) {
+  typedef __segmented_traits<_SegIter> _Traits;
+  typename _Traits::_Segment __seg = _Traits::_S_segment(__first1);
+  typename _Traits::_Segment __slast = _Traits::_S_segment(__last1);
+  typename _Traits::_Local __cur = _Traits::_S_local(__first1);
+  for (;;) {
+    typename _Traits::_Local __end = __seg == __slast
+      ? _Traits::_S_local(__last1) : _Traits::_S_end(__seg);
+    for ( ; __cur != __end; ++__cur, ++__first2) {
+      if (__first2 == __last2)
+        return false;
+      if (*__cur < *__first2)
+        return true;
+      if (*__first2 < *__cur)
+        return false;
+    }
+    if (__seg == __slast)
+      return __first2 != __last2;
+    ++__seg;
+    __cur = _Traits::_S_begin(__seg);
+  }
+}
+
+//汾һĬϱȽϲΪless
+template <class _InputIter1, class _InputIter2>
 bool lexicographical_compare(_InputIter1 __first1, _InputIter1 __last1,
-                             _InputIter2 __first2, _InputIter2 __last2,
-                             _Compare __comp) {
+                             _InputIter2 __first2, _InputIter2 __last2) {
   __STL_REQUIRES(_InputIter1, _InputIterator);
   __STL_REQUIRES(_InputIter2, _InputIterator);
+  __STL_REQUIRES(typename iterator_traits<_InputIter1>::value_type,
+                 _LessThanComparable);
+  __STL_REQUIRES(typename iterator_traits<_InputIter2>::value_type,
+                 _LessThanComparable);
+  typedef typename __segmented_traits<_InputIter1>::_Is_segmented
+          _Segmented;
+  return __lexicographical_compare_aux(__first1, __last1, __first2, __last2,
+                                       _Segmented());
+}
+
+template <class _InputIter1, class _InputIter2, class _Compare>
+bool __lexicographical_compare_aux(_InputIter1 __first1, _InputIter1 __last1,
+                                   _InputIter2 __first2, _InputIter2 __last2,
+                                   _Compare __comp, __false_type) {
   //κһеβˣоӦԪؽбȽ
   for ( ; __first1 != __last1 && __first2 != __last2
         ; ++__first1, ++__first2) {
@@ -755,6 +1017,45 @@ bool lexicographical_compare(_InputIter1 __first1, _InputIter1 __last1,
   return __first1 == __last1 && __first2 != __last2;
 }
 
+template <class _SegIter, class _InputIter2, class _Compare>
+bool __lexicographical_compare_aux(_SegIter __first1, _SegIter __last1,
+                                   _InputIter2 __first2, _InputIter2 __last2,
+                                   _Compare __comp, __true_type) {
+  typedef __segmented_traits<_SegIter> _Traits;
+  typename _Traits::_Segment __seg = _Traits::_S_segment(__first1);
+  typename _Traits::_Segment __slast = _Traits::_S_segment(__last1);
+  typename _Traits::_Local __cur = _Traits::_S_local(__first1);
+  for (;;) {
+    typename _Traits::_Local __end = __seg == __slast
+      ? _Traits::_S_local(__last1) : _Traits::_S_end(__seg);
+    for ( ; __cur != __end; ++__cur, ++__first2) {
+      if (__first2 == __last2)
+        return false;
+      if (__comp(*__cur, *__first2))
+        return true;
+      if (__comp(*__first2, *__cur))
+        return false;
+    }
+    if (__seg == __slast)
+      return __first2 != __last2;
+    ++__seg;
+    __cur = _Traits::_S_begin(__seg);
+  }
+}
+
+//汾ûָȽϹ
+template <class _InputIter1, class _InputIter2, class _Compare>
+bool lexicographical_compare(_InputIter1 __first1, _InputIter1 __last1,
+                             _InputIter2 __first2, _InputIter2 __last2,
+                             _Compare __comp) {
+  __STL_REQUIRES(_InputIter1, _InputIterator);
+  __STL_REQUIRES(_InputIter2, _InputIterator);
+  typedef typename __segmented_traits<_InputIter1>::_Is_segmented
+          _Segmented;
+  return __lexicographical_compare_aux(__first1, __last1, __first2, __last2,
+                                       __comp, _Segmented());
+}
+
 //const unsigned cahr*ػ汾
 inline bool 
 lexicographical_compare(const unsigned char* __first1,
@@ -14,6 +14,38 @@ __STL_BEGIN_NAMESPACE
 		T accumulate (InputIterator first, InputIterator last, T init,
 					 BinaryOperation binary_op);
 */
+template <class _InputIterator, class _Tp>
+inline _Tp __accumulate_aux(_InputIterator __first, _InputIterator __last,
+                            _Tp __init, __false_type)
+{
+  for ( ; __first != __last; ++__first)//ָΧԪ
+    __init = __init + *__first;//ÿԪۼӵʼֵinit
+  return __init;
+}
+
+// A segmented range (a deque; see __segmented_traits in stl_algobase.h)
+// is summed one segment at a time, each as a pointer range.  The order
+// of the additions is unchanged.
+template <class _SegIter, class _Tp>
+_Tp __accumulate_aux(_SegIter __first, _SegIter __last, _Tp __init,
+                     __true_type)
+{
+  typedef __segmented_traits<_SegIter> _Traits;
+  typename _Traits::_Segment __sfirst = _Traits::_S_segment(__first);
+  typename _Traits::_Segment __slast = _Traits::_S_segment(__last);
+  if (__sfirst == __slast)
+    return __accumulate_aux(_Traits::_S_local(__first),
+                            _Traits::_S_local(__last), __init, __false_type());
+  __init = __accumulate_aux(_Traits::_S_local(__first),
+                            _Traits::_S_end(__sfirst), __init, __false_type());
+  for (++__sfirst; __sfirst != __slast; ++__sfirst)
+    __init = __accumulate_aux(_Traits::_S_begin(__sfirst),
+                              _Traits::_S_end(__sfirst), __init,
+                              __false_type());
+  return __accumulate_aux(_Traits::_S_begin(__slast),
+                          _Traits::_S_local(__last), __init, __false_type());
+}
+
 //һ汾Ĭϲۼ
 //[first,last)Ԫinitĺ
 //һ
@@ -21,19 +53,54 @@ template <class _InputIterator, class _Tp>
 _Tp accumulate(_InputIterator __first, _InputIterator __last, _Tp __init)
 {
   __STL_REQUIRES(_InputIterator, _InputIterator);
+  typedef typename __segmented_traits<_InputIterator>::_Is_segmented
+          _Segmented;
+  return __accumulate_aux(__first, __last, __init, _Segmented());
+}
+
+template <class _InputIterator, class _Tp, class _BinaryOperation>
+inline _Tp __accumulate_aux(_InputIterator __first, _InputIterator __last,
+                            _Tp __init, _BinaryOperation __binary_op,
+                            __false_type)
+{
   for ( ; __first != __last; ++__first)//ָΧԪ
-    __init = __init + *__first;//ÿԪۼӵʼֵinit
+    __init = __binary_op(__init, *__first);//ÿԪִжԪ
   return __init;
 }
+
+template <class _SegIter, class _Tp, class _BinaryOperation>
+_Tp __accumulate_aux(_SegIter __first, _SegIter __last, _Tp __init,
+                     _BinaryOperation __binary_op, __true_type)
+{
+  typedef __segmented_traits<_SegIter> _Traits;
+  typename _Traits::_Segment __sfirst = _Traits::_S_segment(__first);
+  typename _Traits::_Segment __slast = _Traits::_S_segment(__last);
+  if (__sfirst == __slast)
+    return __accumulate_aux(_Traits::_S_local(__first),
+                            _Traits::_S_local(__last), __init, __binary_op,
+                            __false_type());
+  __init = __accumulate_aux(_Traits::_S_local(__first),
+                            _Traits::_S_end(__sfirst), __init, __binary_op,
+                            __false_type());
+  for (++__sfirst; __sfirst != __slast; ++__sfirst)
+    __init = __accumulate_aux(_Traits::_S_begin(__sfirst),
+                              _Traits::_S_end(__sfirst), __init, __binary_op,
+                              __false_type());
+  return __accumulate_aux(_Traits::_S_begin(__slast),
+                          _Traits::_S_local(__last), __init, __binary_op,
+                          __false_type());
+}
+
 //ڶ汾ûָԪ
 template <class _InputIterator, class _Tp, class _BinaryOperation>
 _Tp accumulate(_InputIterator __first, _InputIterator __last, _Tp __init,
                _BinaryOperation __binary_op)
 {
   __STL_REQUIRES(_InputIterator, _InputIterator);
-  for ( ; __first != __last; ++__first)//ָΧԪ
-    __init = __binary_op(__init, *__first);//ÿԪִжԪ
-  return __init;
+  typedef typename __segmented_traits<_InputIterator>::_Is_segmented
+          _Segmented;
+  return __accumulate_aux(__first, __last, __init, __binary_op,
+                          _Segmented());
 }
 //ӣ
 /*accumulate example:
@@ -0,0 +1,296 @@
+/*this program belongs in the file of stl_alloc.h, after the second-level allocator */
+//(arena)ֻ䡢գresetʱͷ
+// A monotonic (bump pointer) allocator for request-scoped data
+// structures.  allocate hands out the next __n bytes of the current
+// block, deallocate does nothing, and reset gives every block back at
+// once.  Per-node containers (list, slist, _Rb_tree, hashtable, deque)
+// then pay neither a free-list lookup nor a lock for each node, and
+// tearing a structure down costs one reset.
+//
+// __arena is the storage itself.  It comes in two wrappers:
+//   __arena_alloc_template<threads, inst>: a static, SGI-style allocator
+//     like alloc; each inst is a separate arena, e.g.
+//     list<int, __arena_alloc_template<false, 1> >.
+//   arena_allocator<_Tp>: a standard allocator bound to one __arena
+//     object, for arenas that live and die with a request.
+
+class __arena {
+private:
+  enum {_ALIGN = 8};//ϵ߽
+  enum {_BLOCK_BYTES = 64 * 1024};//ÿmallocĿС
+
+  struct _Block {//ͷɵ
+    _Block* _M_next;
+    size_t _M_size;//пɹиֽ(ͷ)
+  };
+  enum {_HEADER = (sizeof(_Block) + _ALIGN - 1) & ~(_ALIGN - 1)};
+
+  _Block* _M_blocks;//µĿͷ
+  char* _M_cur;//ǰһλ
+  char* _M_end;//ǰĽλ
+  size_t _M_used;//ѽͻ˵ֽ
+
+  static size_t _S_round_up(size_t __bytes)
+    { return (((__bytes) + (size_t) _ALIGN-1) & ~((size_t) _ALIGN - 1)); }
+
+  // Gets a block of at least __n bytes and makes it current, unless
+  // __n is so large that it gets a block of its own.
+  void* _M_allocate_slow(size_t __n)
+  {
+    size_t __bytes = __n > (size_t) _BLOCK_BYTES / 4 ? __n
+                                                      : (size_t) _BLOCK_BYTES;
+    _Block* __b = (_Block*)malloc_alloc::allocate(_HEADER + __bytes);
+    char* __data = (char*)__b + _HEADER;
+
+    __b -> _M_size = __bytes;
+    if (__bytes == __n && 0 != _M_blocks) {
+      //鵥ʹãڵǰ֮󣬵ǰʣռԿɼи
+      __b -> _M_next = _M_blocks -> _M_next;
+      _M_blocks -> _M_next = __b;
+      return __data;
+    }
+    __b -> _M_next = _M_blocks;
+    _M_blocks = __b;
+    _M_cur = __data + __n;
+    _M_end = __data + __bytes;
+    return __data;
+  }
+
+  __arena(const __arena&);
+  void operator=(const __arena&);
+
+public:
+  __arena() : _M_blocks(0), _M_cur(0), _M_end(0), _M_used(0) {}
+  ~__arena() { release(); }
+
+  /* __n must be > 0 */
+  void* allocate(size_t __n)
+  {
+    __n = _S_round_up(__n);
+    _M_used += __n;
+    if ((size_t)(_M_end - _M_cur) >= __n) {//ǰʣռ㹻ֱи
+      void* __result = _M_cur;
+      _M_cur += __n;
+      return __result;
+    }
+    return _M_allocate_slow(__n);
+  }
+
+  // Grows the most recent allocation in place when it can.
+  void* reallocate(void* __p, size_t __old_sz, size_t __new_sz)
+  {
+    size_t __old = _S_round_up(__old_sz);
+    size_t __new = _S_round_up(__new_sz);
+    if ((char*)__p + __old == _M_cur
+        && (__new <= __old || __new - __old <= (size_t)(_M_end - _M_cur))) {
+      //__pһηĿռ䣬ԭ
+      _M_cur = (char*)__p + __new;
+      _M_used = _M_used + __new - __old;
+      return __p;
+    }
+    if (__new <= __old)
+      return __p;
+    void* __result = allocate(__new_sz);
+    memcpy(__result, __p, __old_sz);
+    return __result;
+  }
+
+  // Releases everything allocated so far.  The newest ordinary block is
+  // kept, so an arena reused for request after request stops calling
+  // malloc once it has warmed up.
+  void reset()
+  {
+    _Block* __keep = _M_blocks;
+    if (0 != __keep && __keep -> _M_size == (size_t) _BLOCK_BYTES) {
+      _M_blocks = __keep -> _M_next;
+      __keep -> _M_next = 0;
+    } else
+      __keep = 0;
+    release();
+    if (0 != __keep) {
+      _M_blocks = __keep;
+      _M_cur = (char*)__keep + _HEADER;
+      _M_end = _M_cur + __keep -> _M_size;
+    }
+  }
+
+  // Gives every block back to malloc.
+  void release()
+  {
+    _Block* __b = _M_blocks;
+    while (0 != __b) {
+      _Block* __next = __b -> _M_next;
+      malloc_alloc::deallocate(__b, _HEADER + __b -> _M_size);
+      __b = __next;
+    }
+    _M_blocks = 0;
+    _M_cur = _M_end = 0;
+    _M_used = 0;
+  }
+
+  size_t used() const { return _M_used; }//ϴresetֽ
+};
+
+// Static arena, usable anywhere alloc is: simple_alloc, the _Alloc
+// parameter of every container, and _Alloc_traits below.
+template <bool threads, int inst>
+class __arena_alloc_template {
+private:
+  static __arena _S_arena;
+
+# ifdef __STL_THREADS
+  static _STL_mutex_lock _S_arena_lock;
+# endif
+  class _Lock;
+  friend class _Lock;
+  class _Lock {//̹߳ͬһarenaʱĻ
+    public:
+# ifdef __STL_THREADS
+      _Lock() { if (threads) _S_arena_lock._M_acquire_lock(); }
+      ~_Lock() { if (threads) _S_arena_lock._M_release_lock(); }
+# else
+      _Lock() {}
+# endif
+  };
+
+public:
+  static void* allocate(size_t __n)
+  {
+    /*REFERENCED*/
+    _Lock __lock_instance;
+    return _S_arena.allocate(__n);
+  }
+
+  static void deallocate(void*, size_t) {}//գresetͷ
+
+  static void* reallocate(void* __p, size_t __old_sz, size_t __new_sz)
+  {
+    /*REFERENCED*/
+    _Lock __lock_instance;
+    return _S_arena.reallocate(__p, __old_sz, __new_sz);
+  }
+
+  // Every container built on this arena must be dead (or never touched
+  // again) before reset.
+  static void reset()
+  {
+    /*REFERENCED*/
+    _Lock __lock_instance;
+    _S_arena.reset();
+  }
+
+  static size_t used() { return _S_arena.used(); }
+};
+
+template <bool __threads, int __inst>
+__arena __arena_alloc_template<__threads, __inst>::_S_arena;
+
+# ifdef __STL_THREADS
+template <bool __threads, int __inst>
+_STL_mutex_lock
+__arena_alloc_template<__threads, __inst>::_S_arena_lock
+  __STL_MUTEX_INITIALIZER;
+# endif
+
+// Standard-conforming allocator drawing on one __arena object.  Copies
+// and rebinds share the arena; the arena must outlive every container
+// that uses it.
+template <class _Tp>
+class arena_allocator {
+public:
+  typedef size_t     size_type;
+  typedef ptrdiff_t  difference_type;
+  typedef _Tp*       pointer;
+  typedef const _Tp* const_pointer;
+  typedef _Tp&       reference;
+  typedef const _Tp& const_reference;
+  typedef _Tp        value_type;
+
+  template <class _Tp1> struct rebind {
+    typedef arena_allocator<_Tp1> other;
+  };
+
+  arena_allocator(__arena& __a) __STL_NOTHROW : _M_arena(&__a) {}
+  arena_allocator(const arena_allocator& __x) __STL_NOTHROW
+    : _M_arena(__x._M_arena) {}
+  template <class _Tp1> arena_allocator(const arena_allocator<_Tp1>& __x)
+    __STL_NOTHROW : _M_arena(__x._M_arena) {}
+  ~arena_allocator() __STL_NOTHROW {}
+
+  pointer address(reference __x) const { return &__x; }
+  const_pointer address(const_reference __x) const { return &__x; }
+
+  _Tp* allocate(size_type __n, const void* = 0) {
+    return __n != 0 ? static_cast<_Tp*>(_M_arena->allocate(__n * sizeof(_Tp)))
+                    : 0;
+  }
+
+  void deallocate(pointer, size_type) {}//arenaͷ
+
+  size_type max_size() const __STL_NOTHROW
+    { return size_t(-1) / sizeof(_Tp); }
+
+  void construct(pointer __p, const _Tp& __val) { new(__p) _Tp(__val); }
+  void destroy(pointer __p) { __p->~_Tp(); }
+
+  __arena* _M_arena;
+};
+
+template <class _T1, class _T2>
+inline bool operator==(const arena_allocator<_T1>& __a1,
+                       const arena_allocator<_T2>& __a2)
+{
+  return __a1._M_arena == __a2._M_arena;
+}
+
+template <class _T1, class _T2>
+inline bool operator!=(const arena_allocator<_T1>& __a1,
+                       const arena_allocator<_T2>& __a2)
+{
+  return __a1._M_arena != __a2._M_arena;
+}
+
+#ifdef __STL_USE_STD_ALLOCATORS
+// The static arena needs no instance in each container.  arena_allocator
+// is covered by the general _Alloc_traits, through rebind.
+template <class _Tp, bool __threads, int __inst>
+struct _Alloc_traits<_Tp, __arena_alloc_template<__threads, __inst> >
+{
+  static const bool _S_instanceless = true;
+  typedef simple_alloc<_Tp, __arena_alloc_template<__threads, __inst> >
+          _Alloc_type;
+  typedef __allocator<_Tp, __arena_alloc_template<__threads, __inst> >
+          allocator_type;
+};
+#endif /* __STL_USE_STD_ALLOCATORS */
+
+// Bulk frees cost nothing either: the chain is never walked.
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
+template <bool __threads, int __inst>
+struct __chain_dealloc<__arena_alloc_template<__threads, __inst> > {
+  static void _S_deallocate(void*, void*, size_t, size_t) {}
+};
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
+template <class _Tp>
+inline void __deallocate_chain(arena_allocator<_Tp>&, _Tp*, _Tp*, size_t) {}
+
+// A vector that was the last thing allocated grows in place.
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
+template <bool __threads, int __inst>
+struct __block_realloc<__arena_alloc_template<__threads, __inst> > {
+  static void* _S_reallocate(void* __p, size_t __old_sz, size_t __new_sz)
+  {
+    return __arena_alloc_template<__threads, __inst>::reallocate(
+             __p, __old_sz, __new_sz);
+  }
+};
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
+template <class _Tp>
+inline _Tp* __reallocate_block(arena_allocator<_Tp>& __a, _Tp* __p,
+                               size_t __old_n, size_t __new_n)
+{
+  return (_Tp*) __a._M_arena->reallocate(__p, __old_n * sizeof(_Tp),
+                                         __new_n * sizeof(_Tp));
+}
@@ -64,11 +64,72 @@ private:
     __malloc_alloc_oom_handler = __f;
     return(__old);
   }
+
+#ifdef __STL_ALLOC_STATS
+public:
+  // How many times the out-of-memory handler has been called.
+  static size_t oom_handler_calls() { return _S_oom_handler_calls; }
+private:
+  static size_t __STL_VOLATILE _S_oom_handler_calls;
+  // Several threads may run out of memory at once, and this allocator
+  // holds no lock of its own, so the count is bumped atomically.
+  static void _S_count_oom_call()
+  {
+#   if defined(__STL_THREADS) && defined(__GNUC__)
+    __sync_fetch_and_add(&_S_oom_handler_calls, 1);
+#   else
+    ++_S_oom_handler_calls;
+#   endif
+  }
+#endif
 //line 152 to 155
 #ifndef __STL_STATIC_TEMPLATE_MEMBER_BUG
 template <int __inst>
 void (* __malloc_alloc_template<__inst>::__malloc_alloc_oom_handler)() = 0;
 #endif
+
+#ifdef __STL_ALLOC_STATS
+template <int __inst>
+size_t __STL_VOLATILE __malloc_alloc_template<__inst>::_S_oom_handler_calls = 0;
+#endif
+
+//ڴ治ʱô̲ãֱɹ
+template <int __inst>
+void*
+__malloc_alloc_template<__inst>::_S_oom_malloc(size_t __n)
+{
+    void (* __my_malloc_handler)();
+    void* __result;
+
+    for (;;) {
+        __my_malloc_handler = __malloc_alloc_oom_handler;
+        if (0 == __my_malloc_handler) { __THROW_BAD_ALLOC; }
+#ifdef __STL_ALLOC_STATS
+        _S_count_oom_call();
+#endif
+        (*__my_malloc_handler)();
+        __result = malloc(__n);
+        if (__result) return(__result);
+    }
+}
+
+template <int __inst>
+void* __malloc_alloc_template<__inst>::_S_oom_realloc(void* __p, size_t __n)
+{
+    void (* __my_malloc_handler)();
+    void* __result;
+
+    for (;;) {
+        __my_malloc_handler = __malloc_alloc_oom_handler;
+        if (0 == __my_malloc_handler) { __THROW_BAD_ALLOC; }
+#ifdef __STL_ALLOC_STATS
+        _S_count_oom_call();
+#endif
+        (*__my_malloc_handler)();
+        __result = realloc(__p, __n);
+        if (__result) return(__result);
+    }
+}
 //line 41 to 50
 #ifndef __THROW_BAD_ALLOC
 #  if defined(__STL_NO_BAD_ALLOC) || !defined(__STL_USE_EXCEPTIONS)
@@ -1,19 +1,305 @@
 /*tihs program is in the file of stl_alloc.h from line 288 to 375 */
+// Size-class policies for __default_alloc_template.  A policy gives the
+// alignment and smallest block size (_ALIGN, a power of two), the
+// largest request served from the pool (_MAX_BYTES), the number of free
+// lists, and the mapping from a request size to its free list and from
+// a free list to its block size.  Every block size is a multiple of
+// _ALIGN.
+
+// One class every __align bytes.  __linear_size_classes<8, 128> is the
+// classic SGI layout of 16 free lists.
+template <size_t __align, size_t __max_bytes>
+struct __linear_size_classes {
+  enum {_ALIGN = __align};
+  enum {_MAX_BYTES = __max_bytes};
+  enum {_NFREELISTS = __max_bytes / __align};
+  static size_t _S_freelist_index(size_t __bytes)
+    { return (((__bytes) + (size_t)_ALIGN-1)/(size_t)_ALIGN - 1); }
+  static size_t _S_class_size(size_t __index)
+    { return (__index + 1) * (size_t) _ALIGN; }
+};
+
+template <size_t __n>
+struct __static_log2 {
+  enum {_M_value = 1 + __static_log2<__n / 2>::_M_value};
+};
+template <>
+struct __static_log2<1> {
+  enum {_M_value = 0};
+};
+
+// Linear classes up to 8 * __align, then four classes for every power
+// of two up to __max_bytes (itself a power of two), so the waste stays
+// under 25% while a 4 KB cutoff needs only a few dozen free lists.
+// With __align = 8: 8, 16, ..., 64, 80, 96, 112, 128, 160, 192, ...
+template <size_t __align, size_t __max_bytes>
+struct __geometric_size_classes {
+  enum {_ALIGN = __align};
+  enum {_MAX_BYTES = __max_bytes};
+  enum {_LINEAR_CLASSES = 8};//
+  enum {_LINEAR_SHIFT = __static_log2<_LINEAR_CLASSES * __align>::_M_value};
+  enum {_NFREELISTS = _LINEAR_CLASSES
+          + 4 * (__static_log2<__max_bytes>::_M_value - _LINEAR_SHIFT)};
+  static size_t _S_freelist_index(size_t __bytes) {
+    size_t __k = _LINEAR_SHIFT;
+    if (__bytes <= ((size_t) 1 << _LINEAR_SHIFT))
+      return (((__bytes) + (size_t)_ALIGN-1)/(size_t)_ALIGN - 1);
+    while (((size_t) 1 << (__k + 1)) < __bytes)//2^k < __bytes <= 2^(k+1)
+      ++__k;
+    size_t __step = (size_t) 1 << (__k - 2);
+    return _LINEAR_CLASSES + (__k - _LINEAR_SHIFT) * 4
+           + (__bytes - ((size_t) 1 << __k) + __step - 1) / __step - 1;
+  }
+  static size_t _S_class_size(size_t __index) {
+    if (__index < (size_t) _LINEAR_CLASSES)
+      return (__index + 1) * (size_t) _ALIGN;
+    __index -= _LINEAR_CLASSES;
+    size_t __k = _LINEAR_SHIFT + __index / 4;
+    return ((size_t) 1 << __k) + (__index % 4 + 1) * ((size_t) 1 << (__k - 2));
+  }
+};
+
+// Bounds for __STL_NODE_ALLOC_ADAPTIVE_REFILL: the fewest and most
+// objects one _S_refill may ask for, and the most bytes it may carve.
+# ifdef __STL_NODE_ALLOC_ADAPTIVE_REFILL
+#   ifndef __STL_NODE_ALLOC_REFILL_MIN
+#     define __STL_NODE_ALLOC_REFILL_MIN 8
+#   endif
+#   ifndef __STL_NODE_ALLOC_REFILL_MAX
+#     define __STL_NODE_ALLOC_REFILL_MAX 256
+#   endif
+#   ifndef __STL_NODE_ALLOC_REFILL_MAX_BYTES
+#     define __STL_NODE_ALLOC_REFILL_MAX_BYTES 32768
+#   endif
+# endif /* __STL_NODE_ALLOC_ADAPTIVE_REFILL */
+
+// Chunk sources for __default_alloc_template.  _S_allocate returns at
+// least __bytes bytes, or 0 if none are available, and may round
+// __bytes up to what it actually handed out; the pool then uses all of
+// it.  _S_deallocate gets back the pointer and that rounded size.
+
+// Chunks from malloc, as SGI has always done.
+struct __malloc_chunk_source {
+  static void* _S_allocate(size_t& __bytes) { return malloc(__bytes); }
+  static void _S_deallocate(void* __p, size_t) { free(__p); }
+};
+
+# ifdef __STL_NODE_ALLOC_MMAP
+#   include <sys/mman.h>
+#   include <unistd.h>
+#   ifndef __STL_NODE_ALLOC_HUGE_PAGE_SIZE
+#     define __STL_NODE_ALLOC_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#   endif
+
+// Chunks mapped straight from the kernel.  Under
+// __STL_NODE_ALLOC_HUGE_PAGES every chunk is rounded up to whole huge
+// pages so large tree and hashtable heaps take fewer TLB misses: it first
+// tries reserved huge pages (MAP_HUGETLB), and when none are available
+// maps normal pages and asks for transparent huge pages instead.
+struct __mmap_chunk_source {
+  static void* _S_map(size_t __bytes, int __flags)
+  {
+    void* __p = mmap(0, __bytes, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | __flags, -1, 0);
+    return MAP_FAILED == __p ? 0 : __p;
+  }
+
+  static void* _S_allocate(size_t& __bytes)
+  {
+    void* __p;
+#   ifdef __STL_NODE_ALLOC_HUGE_PAGES
+    const size_t __huge = __STL_NODE_ALLOC_HUGE_PAGE_SIZE;
+    __bytes = (__bytes + __huge - 1) & ~(__huge - 1);//ϵΪҳ
+#     ifdef MAP_HUGETLB
+    static bool __no_hugetlb = false;//Ԥҳٳ
+    if (!__no_hugetlb) {
+      __p = _S_map(__bytes, MAP_HUGETLB);
+      if (0 != __p)
+        return __p;
+      __no_hugetlb = true;
+    }
+#     endif
+    __p = _S_map(__bytes, 0);//˻ͨҳ
+#     ifdef MADV_HUGEPAGE
+    if (0 != __p)
+      madvise(__p, __bytes, MADV_HUGEPAGE);//ں͸ҳ֧
+#     endif
+#   else
+    const size_t __page = (size_t) sysconf(_SC_PAGESIZE);
+    __bytes = (__bytes + __page - 1) & ~(__page - 1);
+    __p = _S_map(__bytes, 0);
+#   endif /* __STL_NODE_ALLOC_HUGE_PAGES */
+    return __p;
+  }
+
+  static void _S_deallocate(void* __p, size_t __bytes)
+    { munmap(__p, __bytes); }
+};
+#   define __STL_DEFAULT_CHUNK_SOURCE __mmap_chunk_source
+# else
+#   define __STL_DEFAULT_CHUNK_SOURCE __malloc_chunk_source
+# endif /* __STL_NODE_ALLOC_MMAP */
+
+# ifdef __STL_NODE_ALLOC_NUMA
+#   ifndef __linux__
+#     error "__STL_NODE_ALLOC_NUMA needs the Linux getcpu and mbind calls"
+#   endif
+#   include <unistd.h>
+#   include <sys/syscall.h>
+#   ifndef __STL_NODE_ALLOC_NUMA_NODES
+#     define __STL_NODE_ALLOC_NUMA_NODES 4
+#   endif
+#   ifndef __STL_NODE_ALLOC_NUMA_GRANULE_SHIFT
+#     define __STL_NODE_ALLOC_NUMA_GRANULE_SHIFT 16
+#   endif
+
+// Which node each chunk carved from _Base was placed on, so that a
+// freed block goes back to the pool that owns it.  __numa_chunk_source
+// starts every chunk on a granule boundary and makes it whole granules
+// long, so no granule is shared by two chunks, and the map keeps one
+// byte per granule: the node plus one, or 0.  It is a two-level radix
+// table, as for page tables: a lookup is two loads, whatever the number
+// of chunks, and a released chunk just clears its bytes.  Leaves come
+// from malloc and, once published, are never freed.  A block the map
+// does not know (its leaf could not be had, or the pool fell back to
+// malloc_alloc when out of memory) reports -1; freeing it to another
+// node's pool is safe, only not local.
+template <class _Base>
+struct __numa_chunk_map {
+  enum {_GRANULE_SHIFT = __STL_NODE_ALLOC_NUMA_GRANULE_SHIFT};
+  enum {_LEAF_BITS = 16};
+  enum {_ROOT_SIZE = 1 << 16};//48λַռ
+  static unsigned char* __STL_VOLATILE _S_root[_ROOT_SIZE];
+
+  // The leaf holding granule __g; made on demand if __make.
+  static unsigned char* _S_leaf(size_t __g, bool __make)
+  {
+    size_t __r = __g >> _LEAF_BITS;
+    if (__r >= (size_t) _ROOT_SIZE)
+      return 0;
+    unsigned char* __leaf = _S_root[__r];
+    if (0 != __leaf || !__make)
+      return __leaf;
+    __leaf = (unsigned char*) calloc((size_t) 1 << _LEAF_BITS, 1);
+    if (0 == __leaf)
+      return 0;
+#   ifdef __GNUC__
+    if (!__sync_bool_compare_and_swap(_S_root + __r, (unsigned char*) 0,
+                                      __leaf)) {
+      free(__leaf);//߳װøҶ
+      __leaf = _S_root[__r];
+    }
+#   else
+    _S_root[__r] = __leaf;
+#   endif
+    return __leaf;
+  }
+
+  // Records the granules of [__p, __p + __bytes) as __node's, or forgets
+  // them if __node is -1.  Returns false if some were left unrecorded.
+  static bool _S_set(void* __p, size_t __bytes, int __node)
+  {
+    bool __ok = true;
+    size_t __end = ((size_t) __p + __bytes) >> _GRANULE_SHIFT;
+    for (size_t __g = (size_t) __p >> _GRANULE_SHIFT; __g < __end; ++__g) {
+      unsigned char* __leaf = _S_leaf(__g, __node >= 0);
+      if (0 == __leaf)
+        __ok = false;
+      else
+        __leaf[__g & (((size_t) 1 << _LEAF_BITS) - 1)]
+          = (unsigned char) (__node + 1);
+    }
+    return __ok;
+  }
+
+  // Returns the node of the chunk holding __p, or -1.
+  static int _S_owner(void* __p)
+  {
+    size_t __g = (size_t) __p >> _GRANULE_SHIFT;
+    unsigned char* __leaf = _S_leaf(__g, false);
+    return 0 == __leaf
+      ? -1 : (int) __leaf[__g & (((size_t) 1 << _LEAF_BITS) - 1)] - 1;
+  }
+};
+
+template <class _Base>
+unsigned char* __STL_VOLATILE
+__numa_chunk_map<_Base>::_S_root[__numa_chunk_map<_Base>::_ROOT_SIZE];
+
+// Wraps another chunk source and asks the kernel to place the chunk on
+// NUMA node __node (MPOL_PREFERRED, so a full node still spills over).
+// The raw syscall keeps libnuma out of the link line.  Where mbind is
+// refused (single-node kernels, containers) the chunk still lands on
+// the node of the thread that carves it, by first touch.  Each chunk is
+// cut granule-aligned out of a larger one from _Base, whose address and
+// size are kept in a _Tail just past its end.
+template <int __node, class _Base>
+struct __numa_chunk_source {
+  typedef __numa_chunk_map<_Base> _Map;
+  enum {_GRANULE = 1 << _Map::_GRANULE_SHIFT};
+  struct _Tail {
+    void* _M_base;
+    size_t _M_bytes;
+  };
+
+  static void* _S_allocate(size_t& __bytes)
+  {
+    __bytes = (__bytes + _GRANULE - 1) & ~((size_t) _GRANULE - 1);
+    size_t __total = __bytes + _GRANULE + sizeof(_Tail);//_Tail
+    char* __base = (char*) _Base::_S_allocate(__total);
+    if (0 == __base)
+      return 0;
+    char* __p = (char*) (((size_t) __base + _GRANULE - 1)
+                         & ~((size_t) _GRANULE - 1));
+    _Tail* __t = (_Tail*) (__p + __bytes);
+    __t->_M_base = __base;
+    __t->_M_bytes = __total;
+#   ifdef SYS_mbind
+    static bool __no_mbind = false;//mbindʧܹһκٳ
+    if (!__no_mbind) {
+      unsigned long __mask = 1UL << __node;
+      if (0 != syscall(SYS_mbind, __p, __bytes, 1 /* MPOL_PREFERRED */,
+                       &__mask, 8 * sizeof(__mask) + 1, 0))
+        __no_mbind = true;
+    }
+#   endif
+    _Map::_S_set(__p, __bytes, __node);
+    return __p;
+  }
+
+  static void _S_deallocate(void* __p, size_t __bytes)
+  {
+    _Tail* __t = (_Tail*) ((char*) __p + __bytes);
+    _Map::_S_set(__p, __bytes, -1);
+    _Base::_S_deallocate(__t->_M_base, __t->_M_bytes);
+  }
+};
+# endif /* __STL_NODE_ALLOC_NUMA */
+
 //ڶ__default_alloc_template
-template <bool threads, int inst>
+// For example __default_alloc_template<true, 0,
+// __geometric_size_classes<16, 4096> > serves requests up to 4 KB from
+// the pool with 16-byte aligned blocks.  _ChunkSource supplies the
+// memory the pool is carved from.
+template <bool threads, int inst,
+          class _SizeClasses = __linear_size_classes<8, 128>,
+          class _ChunkSource = __STL_DEFAULT_CHUNK_SOURCE>
 class __default_alloc_template {
 
 private:
   // Really we should use static const int x = N
   // instead of enum { x = N }, but few compilers accept the former.
-#if ! (defined(__SUNPRO_CC) || defined(__GNUC__))
-    enum {_ALIGN = 8};//Сϵ߽
-    enum {_MAX_BYTES = 128};//Сڴ
-    enum {_NFREELISTS = 16}; // _MAX_BYTES/_ALIGN;
-# endif
+    enum {_ALIGN = _SizeClasses::_ALIGN};//Сϵ߽
+    enum {_MAX_BYTES = _SizeClasses::_MAX_BYTES};//Сڴ
+    enum {_NFREELISTS = _SizeClasses::_NFREELISTS};//
+  // Chunk sources only promise 8-byte alignment; wider _ALIGN needs
+  // slack so each chunk can be aligned by hand.
+    enum {_CHUNK_SLACK = _ALIGN > 8 ? _ALIGN : 0};
   static size_t
-  _S_round_up(size_t __bytes) //ܣڴСΪ8ı
+  _S_round_up(size_t __bytes) //ܣڴСΪ_ALIGNı
     { return (((__bytes) + (size_t) _ALIGN-1) & ~((size_t) _ALIGN - 1)); }
+  static char* _S_align_chunk(char* __p)//chunkʼַϵ_ALIGNı
+    { return (char*)(((size_t) __p + (size_t) _ALIGN-1) & ~((size_t) _ALIGN - 1)); }
 
 __PRIVATE:
   union _Obj {//ڵ
@@ -21,15 +307,44 @@ __PRIVATE:
         char _M_client_data[1];    /* The client sees this.        */
   };
 private:
+# ifdef __STL_NODE_ALLOC_LOCK_FREE
+    // Each list head packs {pointer, tag} into one double word.  The tag
+    // is bumped on every update, so a compare-and-swap against a stale
+    // head always fails (no ABA).  Pool memory is never unmapped, so
+    // reading the link of a stale head is harmless.
+#   if defined(__x86_64__) || defined(__aarch64__)
+    typedef unsigned __int128 _Free_list_head;//x86-64-mcx16(cmpxchg16b)
+#   else
+    typedef unsigned long long _Free_list_head;
+#   endif
+    static _Obj* _S_head_ptr(_Free_list_head __h)//ȡͷָ벿
+      { return (_Obj*)(size_t)__h; }
+    static _Free_list_head _S_next_head(_Free_list_head __old, _Obj* __p)
+      { return (((__old >> (sizeof(void*) * 8)) + 1) << (sizeof(void*) * 8))
+               | (size_t)__p; }
+# else
+    typedef _Obj* _Free_list_head;
+# endif
 # if defined(__SUNPRO_CC) || defined(__GNUC__) || defined(__HP_aCC)
-    static _Obj* __STL_VOLATILE _S_free_list[]; 
+    static _Free_list_head __STL_VOLATILE _S_free_list[]; 
         // Specifying a size results in duplicate def for 4.1
 # else
-    static _Obj* __STL_VOLATILE _S_free_list[_NFREELISTS]; 
+    static _Free_list_head __STL_VOLATILE _S_free_list[_NFREELISTS]; 
 # endif
   static  size_t _S_freelist_index(size_t __bytes) {//ܣڴжӦĺ,0ʼ
-        return (((__bytes) + (size_t)_ALIGN-1)/(size_t)_ALIGN - 1);
+        return _SizeClasses::_S_freelist_index(__bytes);
   }
+  static size_t _S_class_size(size_t __index)//__indexС
+    { return _SizeClasses::_S_class_size(__index); }
+
+  // Free list primitives.  Callers hold the allocation lock, except
+  // under __STL_NODE_ALLOC_LOCK_FREE, where the threaded instantiation
+  // runs them as a lock-free Treiber stack.
+  static _Obj* _S_free_list_pop(size_t __index);//ȡͷ飬Ϊʱ0
+  // Pushes the already linked chain __first ... __last of __nobjs
+  // objects in one step.
+  static void _S_free_list_push(size_t __index, _Obj* __first, _Obj* __last,
+                                int __nobjs);
 
   // Returns an object of size __n, and optionally adds to size __n free list.
   static void* _S_refill(size_t __n);//ռ,ѴСΪnڴռӵ
@@ -38,11 +353,70 @@ private:
   /*ڴзռ䣬ÿռ__nobjsСΪ__size飬ܻ__nobjs*/
   static char* _S_chunk_alloc(size_t __size, int& __nobjs);
 
+# ifdef __STL_NODE_ALLOC_ADAPTIVE_REFILL
+  // Each free list starts refilling __STL_NODE_ALLOC_REFILL_MIN objects
+  // at a time.  At the next refill we look at how many objects the list
+  // handed out since the last one.  If that is less than twice the last
+  // batch, freed objects are not coming back fast enough and the batch
+  // doubles; if it is more than eight times the batch, the list lives
+  // mostly on recycled objects and the batch halves.
+  static int _S_refill_nobjs[_NFREELISTS];//´β0ʾδ
+  static size_t _S_refill_count[_NFREELISTS];//Ĳ
+  static size_t __STL_VOLATILE _S_served[_NFREELISTS];//ͻ˵
+  static size_t _S_served_at_refill[_NFREELISTS];//ϴβʱ_S_served
+  // Counts __k objects handed out by list __index.
+  static void _S_note_served(size_t __index, size_t __k)
+  {
+#   if defined(__STL_NODE_ALLOC_LOCK_FREE)
+    if (threads) {//ģʽµδ
+      __sync_fetch_and_add(_S_served + __index, __k);
+      return;
+    }
+#   endif
+    _S_served[__index] += __k;
+  }
+  // Returns the batch for this refill of list __index.  We hold the
+  // allocation lock.
+  static int _S_refill_batch(size_t __index);
+# endif /* __STL_NODE_ALLOC_ADAPTIVE_REFILL */
+
   // Chunk allocation state.
   static char* _S_start_free;//ڴʼλ
   static char* _S_end_free;//ڴؽλ
   static size_t _S_heap_size;
 
+# ifdef __STL_NODE_ALLOC_TRIM
+  // Every chunk obtained from malloc starts with a _Chunk header, so
+  // _S_trim can tell which chunk a free block belongs to and give the
+  // chunks whose bytes are all free back to the system.
+  struct _Chunk {
+    _Chunk* _M_next;
+    char* _M_base;//chunkԴصĵַͷʱʹ
+    size_t _M_alloc_size;//chunkԴ뵽ֽ
+    bool _M_from_source;//falseʾڴ治ʱɵһṩ
+    size_t _M_size;//chunkпɹиֽ(ͷ)
+    size_t _M_free_bytes;//_S_trimͳʱʹ
+  };
+  enum {_CHUNK_HEADER = (sizeof(_Chunk) + _ALIGN - 1) & ~(_ALIGN - 1)};
+
+  static _Chunk* _S_chunk_list;//chunkɵ
+  static size_t _S_chunk_count;
+  static size_t _S_free_bytes;//ǰϵֽ
+  static size_t _S_trim_watermark;//0ʾԶ黹
+  static size_t _S_trim_next;//ֵֽʱԶ黹
+
+  // Records the chunk of __alloc_size bytes just obtained at __p, with
+  // __bytes usable after the header; returns where those bytes start.
+  static char* _S_link_chunk(char* __p, size_t __alloc_size, size_t __bytes,
+                             bool __from_source);
+  static int _S_chunk_compare(const void* __a, const void* __b);
+  static _Chunk* _S_find_chunk(_Chunk** __sorted, size_t __n, char* __p);
+  // Returns the number of bytes given back.  We hold the allocation lock.
+  static size_t _S_trim();
+# else
+  enum {_CHUNK_HEADER = 0};
+# endif /* __STL_NODE_ALLOC_TRIM */
+
 # ifdef __STL_THREADS
     static _STL_mutex_lock _S_node_allocator_lock;
 # endif
@@ -57,89 +431,791 @@ private:
             _Lock() { __NODE_ALLOCATOR_LOCK; }
             ~_Lock() { __NODE_ALLOCATOR_UNLOCK; }
     };
-	public:
 
-  /* __n must be > 0      */
-  static void* allocate(size_t __n)
+# ifdef __STL_NODE_ALLOC_LOCK_FREE
+    // Free list updates need no lock.  _S_refill takes _Lock itself,
+    // so only carving a new chunk is serialized.
+    class _Free_list_lock {
+        public:
+            _Free_list_lock() {}
+    };
+# else
+    typedef _Lock _Free_list_lock;
+# endif
+
+# ifdef __STL_NODE_ALLOC_THREAD_CACHE
+    // Per-thread front cache.  Each thread keeps its own short free list
+    // for every size class.  It is refilled from, and flushed back to,
+    // the shared _S_free_list in batches of _CACHE_BATCH objects, so the
+    // common allocate/deallocate path never takes _S_node_allocator_lock.
+    enum {_CACHE_BATCH = 32};//ÿ빲
+    enum {_CACHE_HIGH_WATER = 2 * _CACHE_BATCH};//̻߳ޣ黹һ
+
+    struct _Thread_cache {//߳˽е
+      _Obj* _M_free_list[_NFREELISTS];
+      int _M_count[_NFREELISTS];//ǰ
+    };
+
+    static pthread_key_t _S_cache_key;
+    static pthread_once_t _S_cache_once;
+    static void _S_make_cache_key();
+    static void _S_destroy_cache(void* __c);//߳˳ʱѻ黹
+    static _Thread_cache* _S_get_cache();
+    // Takes the lock once, returns one object of size __n and moves up
+    // to _CACHE_BATCH more into the calling thread's cache.
+    static void* _S_cache_refill(_Thread_cache* __c, size_t __n);
+    // Moves the first __nobjs objects of list __index back to the
+    // shared free list under a single lock.
+    static void _S_cache_flush(_Thread_cache* __c, size_t __index,
+                               int __nobjs);
+# endif /* __STL_NODE_ALLOC_THREAD_CACHE */
+
+# ifdef __STL_ALLOC_STATS
+    // Counters behind stats().  Slot _NFREELISTS of the count arrays is
+    // for requests over _MAX_BYTES, which go to malloc_alloc.  allocate
+    // and deallocate update them with an atomic add, since the per-thread
+    // cache and the lock-free lists run without the lock.
+    static size_t __STL_VOLATILE _S_alloc_count[_NFREELISTS + 1];
+    static size_t __STL_VOLATILE _S_free_count[_NFREELISTS + 1];
+    static size_t __STL_VOLATILE _S_live_bytes;//ѽͻˡδ黹ֽ
+    static size_t _S_chunk_total;//ǰеchunkڳʱ
+
+    static void _S_stat_add(size_t __STL_VOLATILE* __c, size_t __n)
+    {
+#     ifdef __GNUC__
+      if (threads) {
+        __sync_fetch_and_add(__c, __n);
+        return;
+      }
+#     endif
+      *__c += __n;
+    }
+    static void _S_stat_sub(size_t __STL_VOLATILE* __c, size_t __n)
+    {
+#     ifdef __GNUC__
+      if (threads) {
+        __sync_fetch_and_sub(__c, __n);
+        return;
+      }
+#     endif
+      *__c -= __n;
+    }
+# endif /* __STL_ALLOC_STATS */
+
+# ifdef __STL_NODE_ALLOC_DEBUG
+    // Checking mode.  Each block is laid out as
+    //   [link word][state word] client bytes [canary] ...
+    // so the free list threads blocks through the link word and never
+    // through client data.  The state word holds _DEBUG_LIVE or
+    // _DEBUG_FREED, mixed with the block address so a stale mark in
+    // recycled memory does not match.  Freeing a block marked freed is a
+    // double free; any other bad mark, or a damaged canary, is
+    // corruption.  Freed client bytes are filled with _DEBUG_POISON, and
+    // a recycled block is checked for that fill before it is handed out
+    // again, which catches writes after free.  Every check aborts.
+    enum {_DEBUG_HEADER = (2 * sizeof(size_t) + _ALIGN - 1) & ~(_ALIGN - 1)};
+    enum {_DEBUG_OVERHEAD = _DEBUG_HEADER + sizeof(size_t)};//ͷβcanary
+    enum {_DEBUG_POISON = 0xdd};//պֽ
+    enum {_DEBUG_LIVE = 0x5afe10c5, _DEBUG_FREED = 0xdeadf7ee,
+          _DEBUG_CANARY = 0xc0ffee11};
+
+    static size_t __STL_VOLATILE _S_debug_live[_NFREELISTS + 1];//δ黹
+    static int __STL_VOLATILE _S_debug_registered;//ǷѵǼ˳ʱй©
+
+    static size_t _S_debug_mark(void* __b, size_t __state)
+      { return __state ^ (size_t) __b; }
+    // Bytes after the header: the rest of the size class for pool
+    // blocks, just the client bytes and canary for large ones.
+    static size_t _S_debug_space(size_t __n)
+    {
+      size_t __bytes = __n + _DEBUG_OVERHEAD;
+      if (__bytes > (size_t) _MAX_BYTES)
+        return __bytes - _DEBUG_HEADER;
+      return _S_class_size(_S_freelist_index(__bytes)) - _DEBUG_HEADER;
+    }
+    static size_t _S_debug_index(size_t __n)
+    {
+      size_t __bytes = __n + _DEBUG_OVERHEAD;
+      return __bytes > (size_t) _MAX_BYTES ? (size_t) _NFREELISTS
+                                           : _S_freelist_index(__bytes);
+    }
+    static void _S_debug_count(size_t __index, int __delta)
+    {
+#     ifdef __GNUC__
+      if (threads) {
+        __sync_fetch_and_add(_S_debug_live + __index, (size_t) __delta);
+        return;
+      }
+#     endif
+      _S_debug_live[__index] += (size_t) __delta;
+    }
+    static void _S_debug_fail(const char* __what, void* __p, size_t __n);
+    static void _S_debug_atexit();
+
+    // Turns a raw block into the client pointer for a request of __n.
+    static void* _S_debug_checkout(void* __b, size_t __n)
+    {
+      size_t* __h = (size_t*) __b;
+      char* __p = (char*) __b + _DEBUG_HEADER;
+      size_t __canary = _S_debug_mark(__b, _DEBUG_CANARY);
+
+      if (__h[1] == _S_debug_mark(__b, _DEBUG_FREED)
+          && __n + _DEBUG_OVERHEAD <= (size_t) _MAX_BYTES) {//յ飬Ƿ
+        size_t __space = _S_debug_space(__n);
+        for (size_t __i = 0; __i < __space; ++__i)
+          if ((unsigned char) __p[__i] != (unsigned char) _DEBUG_POISON)
+            _S_debug_fail("write after free", __p, __n);
+      }
+      __h[1] = _S_debug_mark(__b, _DEBUG_LIVE);
+      memcpy(__p + __n, &__canary, sizeof(__canary));//βcanaryδ
+      _S_debug_count(_S_debug_index(__n), 1);
+      if (0 == _S_debug_registered) {
+#       ifdef __GNUC__
+        if (__sync_bool_compare_and_swap(&_S_debug_registered, 0, 1))
+          atexit(_S_debug_atexit);
+#       else
+        _S_debug_registered = 1;
+        atexit(_S_debug_atexit);
+#       endif
+      }
+      return __p;
+    }
+
+    // Checks a client pointer coming back and returns its raw block.
+    static void* _S_debug_checkin(void* __p, size_t __n)
+    {
+      char* __b = (char*) __p - _DEBUG_HEADER;
+      size_t* __h = (size_t*) __b;
+      size_t __canary;
+
+      if (__h[1] != _S_debug_mark(__b, _DEBUG_LIVE))
+        _S_debug_fail(__h[1] == _S_debug_mark(__b, _DEBUG_FREED)
+                        ? "double free" : "corrupted block header",
+                      __p, __n);
+      memcpy(&__canary, (char*) __p + __n, sizeof(__canary));
+      if (__canary != _S_debug_mark(__b, _DEBUG_CANARY))
+        _S_debug_fail("write past end of block", __p, __n);
+      __h[1] = _S_debug_mark(__b, _DEBUG_FREED);
+      memset(__p, _DEBUG_POISON, _S_debug_space(__n));//ǿͻݣͷźĶǶֵ
+      _S_debug_count(_S_debug_index(__n), -1);
+      return __b;
+    }
+# endif /* __STL_NODE_ALLOC_DEBUG */
+
+  // The pool itself.  allocate and deallocate wrap it with the guard
+  // words of the checking mode.
+  static void* _S_allocate(size_t __n)
   {
     void* __ret = 0;
 
     if (__n > (size_t) _MAX_BYTES) {
-      __ret = malloc_alloc::allocate(__n);//ڴ128ʱõһ
+      __ret = malloc_alloc::allocate(__n);//ڴ_MAX_BYTESʱõһ
+#     ifdef __STL_ALLOC_STATS
+      _S_stat_add(_S_alloc_count + _NFREELISTS, 1);
+      _S_stat_add(&_S_live_bytes, __n);
+#     endif
     }
     else {
-      _Obj* __STL_VOLATILE* __my_free_list
-          = _S_free_list + _S_freelist_index(__n);
+#     ifdef __STL_ALLOC_STATS
+      _S_stat_add(_S_alloc_count + _S_freelist_index(__n), 1);
+      _S_stat_add(&_S_live_bytes, _S_class_size(_S_freelist_index(__n)));
+#     endif
+#     ifdef __STL_NODE_ALLOC_THREAD_CACHE
+      if (threads) {//Ȳ̻߳棬ʱ
+        _Thread_cache* __c = _S_get_cache();
+        size_t __index = _S_freelist_index(__n);
+        _Obj* __result = __c->_M_free_list[__index];
+        if (0 == __result)
+          return _S_cache_refill(__c, _S_class_size(__index));
+        __c->_M_free_list[__index] = __result -> _M_free_list_link;
+        --__c->_M_count[__index];
+        return __result;
+      }
+#     endif /* __STL_NODE_ALLOC_THREAD_CACHE */
       // Acquire the lock here with a constructor call.
       // This ensures that it is released in exit or during stack
       // unwinding.
 #     ifndef _NOTHREADS
       /*REFERENCED*/
-      _Lock __lock_instance;
+      _Free_list_lock __lock_instance;
+#     endif
+      size_t __index = _S_freelist_index(__n);
+      _Obj* __RESTRICT __result = _S_free_list_pop(__index);
+#     ifdef __STL_NODE_ALLOC_ADAPTIVE_REFILL
+      _S_note_served(__index, 1);
 #     endif
-      _Obj* __RESTRICT __result = *__my_free_list;
       if (__result == 0)//free_listڿõ飬ڴ
-        __ret = _S_refill(_S_round_up(__n));
-      else {//free_listڿ飬free_list
-        *__my_free_list = __result -> _M_free_list_link;
+        __ret = _S_refill(_S_class_size(__index));
+      else//free_listڿ飬Ѵfree_listȡ
         __ret = __result;
-      }
     }
 
     return __ret;
   };
-  /* __p may not be 0 */
-  static void deallocate(void* __p, size_t __n)
+  static void _S_deallocate(void* __p, size_t __n)
   {
-    if (__n > (size_t) _MAX_BYTES)//ڴ128ʱõһ
+#   ifdef __STL_ALLOC_STATS
+    if (__n > (size_t) _MAX_BYTES) {
+      _S_stat_add(_S_free_count + _NFREELISTS, 1);
+      _S_stat_sub(&_S_live_bytes, __n);
+    } else {
+      _S_stat_add(_S_free_count + _S_freelist_index(__n), 1);
+      _S_stat_sub(&_S_live_bytes, _S_class_size(_S_freelist_index(__n)));
+    }
+#   endif
+    if (__n > (size_t) _MAX_BYTES)//ڴ_MAX_BYTESʱõһ
       malloc_alloc::deallocate(__p, __n);
     else {//ҵӦλã
-      _Obj* __STL_VOLATILE*  __my_free_list
-          = _S_free_list + _S_freelist_index(__n);
+#     ifdef __STL_NODE_ALLOC_THREAD_CACHE
+      if (threads) {//黹̻߳棬ʱع
+        _Thread_cache* __c = _S_get_cache();
+        size_t __index = _S_freelist_index(__n);
+        ((_Obj*)__p) -> _M_free_list_link = __c->_M_free_list[__index];
+        __c->_M_free_list[__index] = (_Obj*)__p;
+        if (++__c->_M_count[__index] > (int) _CACHE_HIGH_WATER)
+          _S_cache_flush(__c, __index, (int) _CACHE_BATCH);
+        return;
+      }
+#     endif /* __STL_NODE_ALLOC_THREAD_CACHE */
       _Obj* __q = (_Obj*)__p;
 
       // acquire lock
 #       ifndef _NOTHREADS
       /*REFERENCED*/
-      _Lock __lock_instance;
+      _Free_list_lock __lock_instance;
 #       endif /* _NOTHREADS */
-      __q -> _M_free_list_link = *__my_free_list;
-      *__my_free_list = __q;
+      _S_free_list_push(_S_freelist_index(__n), __q, __q, 1);
+#       ifdef __STL_NODE_ALLOC_TRIM
+      if (0 != _S_trim_watermark && _S_free_bytes > _S_trim_next)
+        _S_trim();//ֽڳˮλߣԶ黹ȫеchunk
+#       endif
       // lock is released here
     }
   }
+
+	public:
+
+  /* __n must be > 0      */
+  static void* allocate(size_t __n)
+  {
+#   ifdef __STL_NODE_ALLOC_DEBUG
+    return _S_debug_checkout(_S_allocate(__n + _DEBUG_OVERHEAD), __n);
+#   else
+    return _S_allocate(__n);
+#   endif
+  }
+
+  /* __p may not be 0 */
+  static void deallocate(void* __p, size_t __n)
+  {
+#   ifdef __STL_NODE_ALLOC_DEBUG
+    _S_deallocate(_S_debug_checkin(__p, __n), __n + _DEBUG_OVERHEAD);
+#   else
+    _S_deallocate(__p, __n);
+#   endif
+  }
+
+  // Resizes the block at __p.  Blocks too big for the pool belong to
+  // malloc_alloc, whose realloc can often grow them where they lie, or
+  // remap their pages, instead of copying them.  Pool blocks are moved
+  // unless both sizes fall in the same size class.
+  static void* reallocate(void* __p, size_t __old_sz, size_t __new_sz)
+  {
+#   ifndef __STL_NODE_ALLOC_DEBUG
+    if (__old_sz > (size_t) _MAX_BYTES && __new_sz > (size_t) _MAX_BYTES) {
+      void* __result = malloc_alloc::reallocate(__p, __old_sz, __new_sz);
+#     ifdef __STL_ALLOC_STATS
+      _S_stat_sub(&_S_live_bytes, __old_sz);
+      _S_stat_add(&_S_live_bytes, __new_sz);
+#     endif
+      return __result;
+    }
+    if (__old_sz <= (size_t) _MAX_BYTES && __new_sz <= (size_t) _MAX_BYTES
+        && _S_freelist_index(__old_sz) == _S_freelist_index(__new_sz))
+      return __p;//¾ɴСͬһsize classԭ鼴
+#   endif /* __STL_NODE_ALLOC_DEBUG */
+    void* __result = allocate(__new_sz);
+    memcpy(__result, __p, __new_sz > __old_sz ? __old_sz : __new_sz);
+    deallocate(__p, __old_sz);
+    return __result;
+  }
+
+  // Frees __nobjs blocks of __n bytes at once.  Each block holds the
+  // address of the next in its first word, ending with __last, so a
+  // container tearing itself down hands over one chain and the free
+  // list takes it in a single splice, under a single lock.  The chain
+  // bypasses the per-thread cache, which it would only overflow.
+  /* __nobjs must be > 0 */
+  static void deallocate_chain(void* __first, void* __last, size_t __n,
+                               size_t __nobjs)
+  {
+#   ifdef __STL_NODE_ALLOC_DEBUG
+    void* __cur = __first;//ģʽ
+    for ( ; __nobjs > 0; --__nobjs) {
+      void* __next = *(void**) __cur;
+      deallocate(__cur, __n);
+      __cur = __next;
+    }
+    return;
+#   endif
+#   ifdef __STL_ALLOC_STATS
+    if (__n > (size_t) _MAX_BYTES) {
+      _S_stat_add(_S_free_count + _NFREELISTS, __nobjs);
+      _S_stat_sub(&_S_live_bytes, __n * __nobjs);
+    } else {
+      _S_stat_add(_S_free_count + _S_freelist_index(__n), __nobjs);
+      _S_stat_sub(&_S_live_bytes,
+                  _S_class_size(_S_freelist_index(__n)) * __nobjs);
+    }
+#   endif
+    if (__n > (size_t) _MAX_BYTES) {//ֻһ
+      _Obj* __p = (_Obj*)__first;
+      for ( ; __nobjs > 0; --__nobjs) {
+        _Obj* __next = __p -> _M_free_list_link;
+        malloc_alloc::deallocate(__p, __n);
+        __p = __next;
+      }
+      return;
+    }
+#   ifndef _NOTHREADS
+    /*REFERENCED*/
+    _Free_list_lock __lock_instance;
+#   endif
+    _S_free_list_push(_S_freelist_index(__n), (_Obj*)__first, (_Obj*)__last,
+                      (int) __nobjs);//һνӵͷ
+#   ifdef __STL_NODE_ALLOC_TRIM
+    if (0 != _S_trim_watermark && _S_free_bytes > _S_trim_next)
+      _S_trim();
+#   endif
+  }
+
+# ifdef __STL_NODE_ALLOC_TRIM
+  // Gives every chunk whose bytes are all back on the free lists to the
+  // system, and returns how many bytes that released.  Blocks parked in
+  // per-thread caches keep their chunks alive.
+  static size_t trim()
+  {
+    /*REFERENCED*/
+    _Lock __lock_instance;
+    return _S_trim();
+  }
+
+  // Once the free lists hold more than __bytes beyond what the last trim
+  // left behind, deallocate trims by itself.  0 (the default) turns the
+  // watermark off.  Returns the previous setting.
+  static size_t set_trim_watermark(size_t __bytes)
+  {
+    /*REFERENCED*/
+    _Lock __lock_instance;
+    size_t __old = _S_trim_watermark;
+    _S_trim_watermark = __bytes;
+    _S_trim_next = _S_free_bytes + __bytes;
+    return __old;
+  }
+# endif /* __STL_NODE_ALLOC_TRIM */
+
+# ifdef __STL_NODE_ALLOC_ADAPTIVE_REFILL
+  // Refill tuning for the free list that serves __bytes: how often it
+  // has been refilled, and how many objects it asks for next time.
+  static size_t refill_count(size_t __bytes)
+    { return _S_refill_count[_S_freelist_index(__bytes)]; }
+  static int refill_batch(size_t __bytes)
+  {
+    int __nobjs = _S_refill_nobjs[_S_freelist_index(__bytes)];
+    return 0 == __nobjs ? __STL_NODE_ALLOC_REFILL_MIN : __nobjs;
+  }
+# endif /* __STL_NODE_ALLOC_ADAPTIVE_REFILL */
+
+# ifdef __STL_ALLOC_STATS
+  // A snapshot of the pool, for sizing it in production.
+  struct stats_type {
+    size_t alloc_count[_NFREELISTS + 1];//СôһΪ_MAX_BYTES
+    size_t free_count[_NFREELISTS + 1];//СͷŴ
+    size_t live_bytes;//ѽͻˡδ黹ֽ(С)
+    size_t heap_size;//_S_heap_size
+    size_t chunk_count;//еchunk
+    size_t pool_bytes;//_S_start_free_S_end_free֮δиֽ
+    size_t oom_calls;//һڴ治㴦̵Ĵ
+  };
+
+  static void stats(stats_type& __s);
+  // Writes the snapshot as text, one line per size class in use.
+  static void print_stats(FILE* __f);
+# endif /* __STL_ALLOC_STATS */
+
+# ifdef __STL_NODE_ALLOC_DEBUG
+  // Writes the blocks not yet freed, per size class, and returns how
+  // many there are.  Runs at exit on stderr when any are left; blocks
+  // owned by containers with static storage are reported too.
+  static size_t leak_report(FILE* __f);
+# endif /* __STL_NODE_ALLOC_DEBUG */
 //ʼ
 //line from 554 to 571
-  template <bool __threads, int __inst>
-char* __default_alloc_template<__threads, __inst>::_S_start_free = 0;
+  template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+char* __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_start_free = 0;
 
-template <bool __threads, int __inst>
-char* __default_alloc_template<__threads, __inst>::_S_end_free = 0;
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+char* __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_end_free = 0;
 
-template <bool __threads, int __inst>
-size_t __default_alloc_template<__threads, __inst>::_S_heap_size = 0;
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+size_t __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_heap_size = 0;
 
-template <bool __threads, int __inst>
-typename __default_alloc_template<__threads, __inst>::_Obj* __STL_VOLATILE
-__default_alloc_template<__threads, __inst> ::_S_free_list[
-# if defined(__SUNPRO_CC) || defined(__GNUC__) || defined(__HP_aCC)
-    _NFREELISTS
-# else
-    __default_alloc_template<__threads, __inst>::_NFREELISTS
-# endif
-] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, };
+# ifdef __STL_NODE_ALLOC_TRIM
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+typename __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_Chunk*
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_chunk_list = 0;
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+size_t __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_chunk_count = 0;
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+size_t __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_free_bytes = 0;
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+size_t __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_trim_watermark = 0;
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+size_t __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_trim_next = 0;
+# endif /* __STL_NODE_ALLOC_TRIM */
+
+# ifdef __STL_NODE_ALLOC_ADAPTIVE_REFILL
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+int __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_refill_nobjs[
+    __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_NFREELISTS];
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+size_t __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_refill_count[
+    __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_NFREELISTS];
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+size_t __STL_VOLATILE __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_served[
+    __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_NFREELISTS];
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+size_t __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_served_at_refill[
+    __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_NFREELISTS];
+# endif /* __STL_NODE_ALLOC_ADAPTIVE_REFILL */
+
+# ifdef __STL_ALLOC_STATS
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+size_t __STL_VOLATILE __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_alloc_count[
+    __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_NFREELISTS + 1];
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+size_t __STL_VOLATILE __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_free_count[
+    __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_NFREELISTS + 1];
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+size_t __STL_VOLATILE __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_live_bytes = 0;
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+size_t __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_chunk_total = 0;
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+void
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::stats(stats_type& __s)
+{
+    size_t __i;
+
+    /*REFERENCED*/
+    _Lock __lock_instance;
+    for (__i = 0; __i <= (size_t) _NFREELISTS; ++__i) {
+      __s.alloc_count[__i] = _S_alloc_count[__i];
+      __s.free_count[__i] = _S_free_count[__i];
+    }
+    __s.live_bytes = _S_live_bytes;
+    __s.heap_size = _S_heap_size;
+    __s.chunk_count = _S_chunk_total;
+    __s.pool_bytes = _S_end_free - _S_start_free;
+    __s.oom_calls = malloc_alloc::oom_handler_calls();
+}
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+void
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::print_stats(FILE* __f)
+{
+    stats_type __s;
+    size_t __i;
+
+    stats(__s);
+    fprintf(__f, "heap %lu bytes in %lu chunks, %lu live, %lu unused in pool,"
+                 " %lu oom handler calls\n",
+            (unsigned long) __s.heap_size, (unsigned long) __s.chunk_count,
+            (unsigned long) __s.live_bytes, (unsigned long) __s.pool_bytes,
+            (unsigned long) __s.oom_calls);
+    for (__i = 0; __i <= (size_t) _NFREELISTS; ++__i) {
+      if (0 == __s.alloc_count[__i])//δʹõС
+        continue;
+      if (__i < (size_t) _NFREELISTS)
+        fprintf(__f, "%6lu:", (unsigned long) _S_class_size(__i));
+      else
+        fprintf(__f, " large:");
+      fprintf(__f, " %lu allocated, %lu freed\n",
+              (unsigned long) __s.alloc_count[__i],
+              (unsigned long) __s.free_count[__i]);
+    }
+}
+# endif /* __STL_ALLOC_STATS */
+
+# ifdef __STL_NODE_ALLOC_DEBUG
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+size_t __STL_VOLATILE __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_debug_live[
+    _NFREELISTS + 1] = {0};
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+int __STL_VOLATILE __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_debug_registered = 0;
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+void
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_debug_fail(
+  const char* __what, void* __p, size_t __n)
+{
+    fprintf(stderr, "node allocator: %s: block %p of %lu bytes\n",
+            __what, __p, (unsigned long) __n);
+    abort();
+}
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+void
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_debug_atexit()
+{
+    leak_report(stderr);
+}
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+size_t
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::leak_report(FILE* __f)
+{
+    size_t __total = 0;
+    size_t __i;
+
+    for (__i = 0; __i <= (size_t) _NFREELISTS; ++__i)
+      __total += _S_debug_live[__i];
+    if (0 == __total)
+      return(0);
+    fprintf(__f, "node allocator: %lu blocks not freed\n",
+            (unsigned long) __total);
+    for (__i = 0; __i <= (size_t) _NFREELISTS; ++__i) {
+      if (0 == _S_debug_live[__i])
+        continue;
+      if (__i < (size_t) _NFREELISTS)//Сõͷβ
+        fprintf(__f, "%6lu:", (unsigned long) _S_class_size(__i));
+      else
+        fprintf(__f, " large:");
+      fprintf(__f, " %lu live\n", (unsigned long) _S_debug_live[__i]);
+    }
+    return(__total);
+}
+# endif /* __STL_NODE_ALLOC_DEBUG */
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+typename __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_Free_list_head __STL_VOLATILE
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource> ::_S_free_list[
+    __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_NFREELISTS
+] = {0};
+
+# ifdef __STL_NODE_ALLOC_LOCK_FREE
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+typename __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_Obj*
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_free_list_pop(size_t __index)
+{
+    _Free_list_head __STL_VOLATILE* __my_free_list = _S_free_list + __index;
+    _Free_list_head __old;
+    _Obj* __result;
+
+    if (!__threads) {//߳ʵԭӲ
+      __result = _S_head_ptr(*__my_free_list);
+      if (0 != __result)
+        *__my_free_list = _S_next_head(*__my_free_list,
+                                       __result -> _M_free_list_link);
+      return(__result);
+    }
+    do {
+      __old = *__my_free_list;
+      __result = _S_head_ptr(__old);
+      if (0 == __result)
+        return(0);
+      // __result may already belong to another thread; then its link is
+      // garbage, but the tag has moved on and the swap below fails.
+    } while (!__sync_bool_compare_and_swap(__my_free_list, __old,
+                 _S_next_head(__old, __result -> _M_free_list_link)));
+    return(__result);
+}
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+void
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_free_list_push(
+  size_t __index, _Obj* __first, _Obj* __last, int)
+{
+    _Free_list_head __STL_VOLATILE* __my_free_list = _S_free_list + __index;
+    _Free_list_head __old;
+
+    if (!__threads) {
+      __last -> _M_free_list_link = _S_head_ptr(*__my_free_list);
+      *__my_free_list = _S_next_head(*__my_free_list, __first);
+      return;
+    }
+    do {
+      __old = *__my_free_list;
+      __last -> _M_free_list_link = _S_head_ptr(__old);
+    } while (!__sync_bool_compare_and_swap(__my_free_list, __old,
+                                           _S_next_head(__old, __first)));
+}
+# else /* __STL_NODE_ALLOC_LOCK_FREE */
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+inline typename __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_Obj*
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_free_list_pop(size_t __index)
+{
+    _Obj* __STL_VOLATILE* __my_free_list = _S_free_list + __index;
+    _Obj* __result = *__my_free_list;
+
+    if (0 != __result) {
+      *__my_free_list = __result -> _M_free_list_link;
+#     ifdef __STL_NODE_ALLOC_TRIM
+      _S_free_bytes -= _S_class_size(__index);
+#     endif
+    }
+    return(__result);
+}
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+inline void
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_free_list_push(
+  size_t __index, _Obj* __first, _Obj* __last, int __nobjs)
+{
+    _Obj* __STL_VOLATILE* __my_free_list = _S_free_list + __index;
+
+    __last -> _M_free_list_link = *__my_free_list;
+    *__my_free_list = __first;
+#   ifdef __STL_NODE_ALLOC_TRIM
+    _S_free_bytes += __nobjs * _S_class_size(__index);
+#   else
+    (void) __nobjs;
+#   endif
+}
+# endif /* __STL_NODE_ALLOC_LOCK_FREE */
+
+# ifdef __STL_NODE_ALLOC_THREAD_CACHE
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+pthread_key_t __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_cache_key;
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+pthread_once_t __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_cache_once
+  = PTHREAD_ONCE_INIT;
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+void
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_make_cache_key()
+{
+    pthread_key_create(&_S_cache_key, _S_destroy_cache);
+}
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+void
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_destroy_cache(void* __p)
+{
+    _Thread_cache* __c = (_Thread_cache*)__p;
+    size_t __i;
+
+    for (__i = 0; __i < (size_t) _NFREELISTS; ++__i) {
+      if (__c->_M_count[__i] > 0)
+        _S_cache_flush(__c, __i, __c->_M_count[__i]);
+    }
+    malloc_alloc::deallocate(__c, sizeof(_Thread_cache));
+}
+
+/* The cache is created lazily, the first time a thread allocates.     */
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+typename __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_Thread_cache*
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_get_cache()
+{
+    pthread_once(&_S_cache_once, _S_make_cache_key);
+    _Thread_cache* __c = (_Thread_cache*)pthread_getspecific(_S_cache_key);
+    if (0 == __c) {
+      __c = (_Thread_cache*)malloc_alloc::allocate(sizeof(_Thread_cache));
+      memset(__c, 0, sizeof(_Thread_cache));
+      pthread_setspecific(_S_cache_key, __c);
+    }
+    return __c;
+}
+
+/* __n is properly aligned, and the cache list for __n is empty.       */
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+void*
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_cache_refill(
+  _Thread_cache* __c, size_t __n)
+{
+    size_t __index = _S_freelist_index(__n);
+    _Obj* __result;
+    _Obj* __head = 0;
+    _Obj* __q;
+    int __i;
+
+    /*REFERENCED*/
+    _Free_list_lock __lock_instance;
+    __result = _S_free_list_pop(__index);
+    if (0 == __result)//ҲΪգ_S_refillڴز
+      __result = (_Obj*)_S_refill(__n);
+    //ٴӹժ_CACHE_BATCH̻߳
+    for (__i = 0; __i < (int) _CACHE_BATCH; ++__i) {
+      __q = _S_free_list_pop(__index);
+      if (0 == __q)
+        break;
+      __q -> _M_free_list_link = __head;
+      __head = __q;
+    }
+    __c->_M_free_list[__index] = __head;
+    __c->_M_count[__index] = __i;
+#   ifdef __STL_NODE_ALLOC_ADAPTIVE_REFILL
+    _S_note_served(__index, __i + 1);//룬
+#   endif
+    return(__result);
+}
+
+/* 0 < __nobjs <= __c->_M_count[__index].                              */
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+void
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_cache_flush(
+  _Thread_cache* __c, size_t __index, int __nobjs)
+{
+    _Obj* __head = __c->_M_free_list[__index];
+    _Obj* __tail = __head;
+    int __i;
+
+    for (__i = 1; __i < __nobjs; ++__i)//ҵҪ黹һ
+      __tail = __tail -> _M_free_list_link;
+    __c->_M_free_list[__index] = __tail -> _M_free_list_link;
+    __c->_M_count[__index] -= __nobjs;
+
+    /*REFERENCED*/
+    _Free_list_lock __lock_instance;
+    _S_free_list_push(__index, __head, __tail, __nobjs);//νӵͷ
+#   ifdef __STL_NODE_ALLOC_TRIM
+    if (0 != _S_trim_watermark && _S_free_bytes > _S_trim_next)
+      _S_trim();
+#   endif
+}
+# endif /* __STL_NODE_ALLOC_THREAD_CACHE */
 
 /* Returns an object of size __n, and optionally adds to size __n free list.*/
-/* We assume that __n is properly aligned.                                */
-/* We hold the allocation lock.                                         */
-template <bool __threads, int __inst>
+/* We assume that __n is a block size of one of the size classes.         */
+/* We hold the allocation lock (under __STL_NODE_ALLOC_LOCK_FREE we     */
+/* take it here, since the caller holds none).                          */
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
 void*
-__default_alloc_template<__threads, __inst>::_S_refill(size_t __n)
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_refill(size_t __n)
 {
+#   ifdef __STL_NODE_ALLOC_LOCK_FREE
+    /*REFERENCED*/
+    _Lock __lock_instance;//ģʽֻдڴиʱż
+#   endif
+#   ifdef __STL_NODE_ALLOC_ADAPTIVE_REFILL
+    int __nobjs = _S_refill_batch(_S_freelist_index(__n));//ϴβķ
+#   else
     int __nobjs = 20;//ĬϽڵ
+#   endif
 	//_S_chunk_allocڴлڴռ
     char* __chunk = _S_chunk_alloc(__n, __nobjs);
-    _Obj* __STL_VOLATILE* __my_free_list;
     _Obj* __result;
     _Obj* __current_obj;
     _Obj* __next_obj;
@@ -147,33 +1223,64 @@ __default_alloc_template<__threads, __inst>::_S_refill(size_t __n)
 
 	//ֻһ飬ظͻˣûн
     if (1 == __nobjs) return(__chunk);
-	//free_list׼½ڵ
-    __my_free_list = _S_free_list + _S_freelist_index(__n);
 
     /* Build free list in chunk */
       __result = (_Obj*)__chunk;//һ鷵ظͻ
-	  //free_listָõĿռ
-      *__my_free_list = __next_obj = (_Obj*)(__chunk + __n);
+	  //õĿռдνӵfree_list
+      __next_obj = (_Obj*)(__chunk + __n);
       for (__i = 1; ; __i++) {//0ظͻˣԴ1ʼ
         __current_obj = __next_obj;
         __next_obj = (_Obj*)((char*)__next_obj + __n);
         if (__nobjs - 1 == __i) {
-            __current_obj -> _M_free_list_link = 0;
             break;
         } else {
             __current_obj -> _M_free_list_link = __next_obj;
         }
       }
+    _S_free_list_push(_S_freelist_index(__n), (_Obj*)(__chunk + __n),
+                      __current_obj, __nobjs - 1);
     return(__result);
 }
 
+# ifdef __STL_NODE_ALLOC_ADAPTIVE_REFILL
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+int
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_refill_batch(size_t __index)
+{
+    size_t __served = _S_served[__index] - _S_served_at_refill[__index];
+    int __nobjs = _S_refill_nobjs[__index];
+    int __max = __STL_NODE_ALLOC_REFILL_MAX;
+    size_t __cap = __STL_NODE_ALLOC_REFILL_MAX_BYTES / _S_class_size(__index);
+
+    if (__cap < (size_t) __max)//ֽԼ
+      __max = (int) __cap;
+    if (__max < __STL_NODE_ALLOC_REFILL_MIN)
+      __max = __STL_NODE_ALLOC_REFILL_MIN;
+    if (0 == __nobjs)//һβ
+      __nobjs = __STL_NODE_ALLOC_REFILL_MIN;
+    else if (__served < 2 * (size_t) __nobjs) {//ܿδ黹ӱ
+      __nobjs *= 2;
+      if (__nobjs > __max)
+        __nobjs = __max;
+    } else if (__served > 8 * (size_t) __nobjs) {//Ҫյ䣬
+      __nobjs /= 2;
+      if (__nobjs < __STL_NODE_ALLOC_REFILL_MIN)
+        __nobjs = __STL_NODE_ALLOC_REFILL_MIN;
+    }
+    _S_refill_nobjs[__index] = __nobjs;
+    _S_served_at_refill[__index] = _S_served[__index];
+    ++_S_refill_count[__index];
+    return(__nobjs);
+}
+# endif /* __STL_NODE_ALLOC_ADAPTIVE_REFILL */
+
 /* We allocate memory in large chunks in order to avoid fragmenting     */
 /* the malloc heap too much.                                            */
-/* We assume that size is properly aligned.                             */
+/* We assume that size is a block size of one of the size classes.      */
 /* We hold the allocation lock.                                         */
-template <bool __threads, int __inst>
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
 char*
-__default_alloc_template<__threads, __inst>::_S_chunk_alloc(size_t __size, 
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_chunk_alloc(size_t __size, 
                                                             int& __nobjs)
 {
     char* __result;
@@ -196,51 +1303,581 @@ __default_alloc_template<__threads, __inst>::_S_chunk_alloc(size_t __size,
         size_t __bytes_to_get = 
 	  2 * __total_bytes + _S_round_up(_S_heap_size >> 4);
         // Try to make use of the left-over piece.
-        if (__bytes_left > 0) {
+        while (__bytes_left > 0) {
 			/*жڴǷвͷڴռ䣬лգfree list*/
-            _Obj* __STL_VOLATILE* __my_free_list =
-                        _S_free_list + _S_freelist_index(__bytes_left);
-
-            ((_Obj*)_S_start_free) -> _M_free_list_link = *__my_free_list;
-            *__my_free_list = (_Obj*)_S_start_free;
+            // The piece need not be a block size; carve it into the
+            // largest classes that fit.  _ALIGN divides every size.
+            size_t __index = _S_freelist_index(__bytes_left);
+            if (_S_class_size(__index) > __bytes_left)
+                --__index;
+            _S_free_list_push(__index, (_Obj*)_S_start_free,
+                              (_Obj*)_S_start_free, 1);
+            _S_start_free += _S_class_size(__index);
+            __bytes_left -= _S_class_size(__index);
         }
-		//ÿõĶѿռ䣬ڴؿռ
-        _S_start_free = (char*)malloc(__bytes_to_get);
+		//chunkԴÿõĿռ䣬ڴؿռ
+        size_t __chunk_bytes = _CHUNK_SLACK + _CHUNK_HEADER + __bytes_to_get;
+#     ifdef __STL_NODE_ALLOC_TRIM
+        bool __from_source = true;
+#     endif
+        _S_start_free = (char*)_ChunkSource::_S_allocate(__chunk_bytes);
         if (0 == _S_start_free) {//ѿռ䲻
             size_t __i;
-            _Obj* __STL_VOLATILE* __my_free_list;
 	    _Obj* __p;
             // Try to make do with what we have.  That can't
             // hurt.  We do not try smaller requests, since that tends
             // to result in disaster on multi-process machines.
-            for (__i = __size;
-                 __i <= (size_t) _MAX_BYTES;
-                 __i += (size_t) _ALIGN) {
+            for (__i = _S_freelist_index(__size);
+                 __i < (size_t) _NFREELISTS;
+                 ++__i) {
 	/*Ѱʵfree listʵָδ飬㹻󣩣Խͷţڴء
 					 **Ȼݹchunk_allocڴȡռ乩free list*/
-                __my_free_list = _S_free_list + _S_freelist_index(__i);
-                __p = *__my_free_list;
+                __p = _S_free_list_pop(__i);
                 if (0 != __p) {//дδʹõ飬ͷŸ
-                    *__my_free_list = __p -> _M_free_list_link;
                     _S_start_free = (char*)__p;
-                    _S_end_free = _S_start_free + __i;
+                    _S_end_free = _S_start_free + _S_class_size(__i);
                     return(_S_chunk_alloc(__size, __nobjs));
                     // Any leftover piece will eventually make it to the
                     // right free list.
                 }
             }
 	    _S_end_free = 0;	// In case of exception.õһ
-            _S_start_free = (char*)malloc_alloc::allocate(__bytes_to_get);
+            __chunk_bytes = _CHUNK_SLACK + _CHUNK_HEADER + __bytes_to_get;
+#         ifdef __STL_NODE_ALLOC_TRIM
+            __from_source = false;
+#         endif
+            _S_start_free = (char*)malloc_alloc::allocate(__chunk_bytes);
             // This should either throw an
             // exception or remedy the situation.  Thus we assume it
             // succeeded.
         }
+        // The source may have rounded the chunk up (to whole pages, say);
+        // put all of it in the pool.
+        __bytes_to_get = (__chunk_bytes - _CHUNK_SLACK - _CHUNK_HEADER)
+                         & ~((size_t) _ALIGN - 1);
+#     ifdef __STL_NODE_ALLOC_TRIM
+        _S_start_free = _S_link_chunk(_S_start_free, __chunk_bytes,
+                                      __bytes_to_get, __from_source);//¼chunk
+#     else
+        _S_start_free = _S_align_chunk(_S_start_free);
+#     endif
         _S_heap_size += __bytes_to_get;
+#     ifdef __STL_ALLOC_STATS
+        ++_S_chunk_total;
+#     endif
         _S_end_free = _S_start_free + __bytes_to_get;
         return(_S_chunk_alloc(__size, __nobjs));
     }
 }
 
+# ifdef __STL_NODE_ALLOC_TRIM
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+char*
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_link_chunk(
+  char* __p, size_t __alloc_size, size_t __bytes, bool __from_source)
+{
+    _Chunk* __c = (_Chunk*)_S_align_chunk(__p);
+
+    __c -> _M_next = _S_chunk_list;
+    __c -> _M_base = __p;
+    __c -> _M_alloc_size = __alloc_size;
+    __c -> _M_from_source = __from_source;
+    __c -> _M_size = __bytes;
+    _S_chunk_list = __c;
+    ++_S_chunk_count;
+    return((char*)__c + _CHUNK_HEADER);
+}
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+int
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_chunk_compare(
+  const void* __a, const void* __b)
+{
+    _Chunk* __x = *(_Chunk* const*)__a;
+    _Chunk* __y = *(_Chunk* const*)__b;
+    return __x < __y ? -1 : (__y < __x ? 1 : 0);
+}
+
+/* __sorted holds the __n chunks in address order.  Returns the chunk   */
+/* whose usable bytes contain __p, or 0.                                */
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+typename __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_Chunk*
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_find_chunk(
+  _Chunk** __sorted, size_t __n, char* __p)
+{
+    size_t __lo = 0;
+    size_t __hi = __n;
+    size_t __mid;
+    _Chunk* __c;
+
+    while (__lo < __hi) {//ֲһʼַ__pchunk
+      __mid = (__lo + __hi) / 2;
+      if ((char*)__sorted[__mid] <= __p)
+        __lo = __mid + 1;
+      else
+        __hi = __mid;
+    }
+    if (0 == __lo)
+      return(0);
+    __c = __sorted[__lo - 1];
+    if (__p < (char*)__c + _CHUNK_HEADER + __c -> _M_size)
+      return(__c);
+    return(0);
+}
+
+/* A chunk is fully free when the free-list blocks and the unused pool  */
+/* bytes inside it add up to its whole size.  Those blocks are taken    */
+/* off the free lists and the chunk is freed.                           */
+/* We hold the allocation lock.                                         */
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+size_t
+__default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>::_S_trim()
+{
+    size_t __n = _S_chunk_count;
+    size_t __released = 0;
+    size_t __i;
+    size_t __bytes;
+    _Chunk** __sorted;
+    _Chunk** __link;
+    _Chunk* __c;
+    _Obj* __STL_VOLATILE* __obj_link;
+    _Obj* __p;
+
+    if (0 == __n)
+      return(0);
+    __sorted = (_Chunk**)malloc_alloc::allocate(__n * sizeof(_Chunk*));
+    for (__i = 0, __c = _S_chunk_list; 0 != __c; __c = __c -> _M_next) {
+      __c -> _M_free_bytes = 0;
+      __sorted[__i++] = __c;
+    }
+    qsort(__sorted, __n, sizeof(_Chunk*), _S_chunk_compare);
+
+    //ͳÿchunkпеֽе飬ԼڴδиĲ
+    for (__i = 0; __i < (size_t) _NFREELISTS; ++__i) {
+      __bytes = _S_class_size(__i);
+      for (__p = _S_free_list[__i]; 0 != __p; __p = __p -> _M_free_list_link) {
+        __c = _S_find_chunk(__sorted, __n, (char*)__p);
+        if (0 != __c)
+          __c -> _M_free_bytes += __bytes;
+      }
+    }
+    if (_S_start_free != _S_end_free) {
+      __c = _S_find_chunk(__sorted, __n, _S_start_free);
+      if (0 != __c)
+        __c -> _M_free_bytes += _S_end_free - _S_start_free;
+    }
+
+    //ժȫchunk
+    for (__i = 0; __i < (size_t) _NFREELISTS; ++__i) {
+      __bytes = _S_class_size(__i);
+      __obj_link = _S_free_list + __i;
+      while (0 != (__p = *__obj_link)) {
+        __c = _S_find_chunk(__sorted, __n, (char*)__p);
+        if (0 != __c && __c -> _M_free_bytes == __c -> _M_size) {
+          *__obj_link = __p -> _M_free_list_link;
+          _S_free_bytes -= __bytes;
+        } else
+          __obj_link = &__p -> _M_free_list_link;
+      }
+    }
+    if (_S_start_free != _S_end_free) {
+      __c = _S_find_chunk(__sorted, __n, _S_start_free);
+      if (0 != __c && __c -> _M_free_bytes == __c -> _M_size)
+        _S_start_free = _S_end_free = 0;
+    }
+    malloc_alloc::deallocate(__sorted, __n * sizeof(_Chunk*));
+
+    //ͷȫеchunk
+    __link = &_S_chunk_list;
+    while (0 != (__c = *__link)) {
+      if (__c -> _M_free_bytes == __c -> _M_size) {
+        *__link = __c -> _M_next;
+        --_S_chunk_count;
+#     ifdef __STL_ALLOC_STATS
+        --_S_chunk_total;
+#     endif
+        _S_heap_size -= __c -> _M_size;
+        __released += __c -> _M_alloc_size;
+        if (__c -> _M_from_source)
+          _ChunkSource::_S_deallocate(__c -> _M_base, __c -> _M_alloc_size);
+        else
+          free(__c -> _M_base);
+      } else
+        __link = &__c -> _M_next;
+    }
+    _S_trim_next = _S_free_bytes + _S_trim_watermark;
+    return(__released);
+}
+# endif /* __STL_NODE_ALLOC_TRIM */
+
+# ifdef __STL_NODE_ALLOC_NUMA
+// One __default_alloc_template per NUMA node, told apart by their chunk
+// sources, so every node has its own pool, free lists and lock.
+// __numa_pool_dispatch<..., __node> picks pool __n among 0 .. __node.
+template <bool threads, int inst, class _SizeClasses, class _ChunkSource,
+          int __node>
+struct __numa_pool_dispatch {
+  typedef __default_alloc_template<threads, inst, _SizeClasses,
+                                   __numa_chunk_source<__node, _ChunkSource> >
+          _Pool;
+  typedef __numa_pool_dispatch<threads, inst, _SizeClasses, _ChunkSource,
+                               __node - 1>
+          _Next;
+
+  static void* allocate(int __n, size_t __bytes)
+    { return __n == __node ? _Pool::allocate(__bytes)
+                           : _Next::allocate(__n, __bytes); }
+  static void deallocate(int __n, void* __p, size_t __bytes)
+  {
+    if (__n == __node)
+      _Pool::deallocate(__p, __bytes);
+    else
+      _Next::deallocate(__n, __p, __bytes);
+  }
+  static void deallocate_chain(int __n, void* __first, void* __last,
+                               size_t __bytes, size_t __nobjs)
+  {
+    if (__n == __node)
+      _Pool::deallocate_chain(__first, __last, __bytes, __nobjs);
+    else
+      _Next::deallocate_chain(__n, __first, __last, __bytes, __nobjs);
+  }
+  static void* reallocate(int __n, void* __p, size_t __old_sz,
+                          size_t __new_sz)
+    { return __n == __node ? _Pool::reallocate(__p, __old_sz, __new_sz)
+                           : _Next::reallocate(__n, __p, __old_sz, __new_sz); }
+#   ifdef __STL_NODE_ALLOC_TRIM
+  static size_t trim() { return _Pool::trim() + _Next::trim(); }
+#   endif
+};
+
+template <bool threads, int inst, class _SizeClasses, class _ChunkSource>
+struct __numa_pool_dispatch<threads, inst, _SizeClasses, _ChunkSource, 0> {
+  typedef __default_alloc_template<threads, inst, _SizeClasses,
+                                   __numa_chunk_source<0, _ChunkSource> >
+          _Pool;
+
+  static void* allocate(int, size_t __bytes)
+    { return _Pool::allocate(__bytes); }
+  static void deallocate(int, void* __p, size_t __bytes)
+    { _Pool::deallocate(__p, __bytes); }
+  static void deallocate_chain(int, void* __first, void* __last,
+                               size_t __bytes, size_t __nobjs)
+    { _Pool::deallocate_chain(__first, __last, __bytes, __nobjs); }
+  static void* reallocate(int, void* __p, size_t __old_sz, size_t __new_sz)
+    { return _Pool::reallocate(__p, __old_sz, __new_sz); }
+#   ifdef __STL_NODE_ALLOC_TRIM
+  static size_t trim() { return _Pool::trim(); }
+#   endif
+};
+
+//NUMAÿ߳ʹڽڵڴ
+// Sends each thread to the pool of the node it runs on.  A freed block
+// goes back to the pool of the node its chunk was placed on, found
+// through __numa_chunk_map; only a block the map does not know joins
+// the current node's free lists, and trim never releases a chunk with
+// blocks on foreign lists.  Statistics are kept per node pool.  Nodes past
+// __STL_NODE_ALLOC_NUMA_NODES share pools; on a single-node machine
+// getcpu always reports node 0 and this is the plain node allocator.
+template <bool threads, int inst,
+          class _SizeClasses = __linear_size_classes<8, 128>,
+          class _ChunkSource = __STL_DEFAULT_CHUNK_SOURCE>
+class __numa_alloc_template {
+private:
+  enum {_RECHECK = 256};//ÿ_RECHECK²ѯһνڵ㣬߳Ǩ
+  typedef __numa_pool_dispatch<threads, inst, _SizeClasses, _ChunkSource,
+                               __STL_NODE_ALLOC_NUMA_NODES - 1>
+          _Pools;
+
+public:
+  static int current_node()
+  {
+    if (1 == __STL_NODE_ALLOC_NUMA_NODES)
+      return 0;
+#   ifdef __GNUC__
+    static __thread int __cached = -1;
+    static __thread unsigned __calls = 0;
+    if (__cached >= 0 && 0 != (++__calls & (_RECHECK - 1)))
+      return __cached;
+#   endif
+    unsigned __node = 0;
+#   ifdef SYS_getcpu
+    unsigned __cpu;
+    if (0 != syscall(SYS_getcpu, &__cpu, &__node, 0))
+      __node = 0;
+#   endif
+    __node %= __STL_NODE_ALLOC_NUMA_NODES;
+#   ifdef __GNUC__
+    __cached = (int) __node;
+#   endif
+    return (int) __node;
+  }
+
+  static void* allocate(size_t __n)
+    { return _Pools::allocate(current_node(), __n); }
+
+  static void deallocate(void* __p, size_t __n)
+    { _Pools::deallocate(_S_owner(__p, __n), __p, __n); }
+
+  // The chain is cut into runs of blocks owned by the same node, and
+  // each run is spliced into its owner's free list.
+  static void deallocate_chain(void* __first, void*, size_t __n,
+                               size_t __nobjs)
+  {
+    void* __run = __first;//ǰεĵһ
+    void* __p = __first;
+    int __node = _S_owner(__first, __n);
+    size_t __k = 1;
+
+    for (--__nobjs; __nobjs > 0; --__nobjs) {
+      void* __next = *(void**)__p;//ȡһ飬ֻᱻд
+      int __next_node = _S_owner(__next, __n);
+      if (__next_node != __node) {
+        _Pools::deallocate_chain(__node, __run, __p, __n, __k);
+        __run = __next;
+        __node = __next_node;
+        __k = 0;
+      }
+      __p = __next;
+      ++__k;
+    }
+    _Pools::deallocate_chain(__node, __run, __p, __n, __k);
+  }
+
+  // A block of the current node is resized by its pool.  One from
+  // another node is moved here: the copy is needed anyway unless the
+  // size class stays the same, and the new block is then local.
+  static void* reallocate(void* __p, size_t __old_sz, size_t __new_sz)
+  {
+    int __here = current_node();
+    int __owner = _S_owner(__p, __old_sz);
+    if (__owner == __here)
+      return _Pools::reallocate(__here, __p, __old_sz, __new_sz);
+    void* __result = _Pools::allocate(__here, __new_sz);
+    memcpy(__result, __p, __new_sz > __old_sz ? __old_sz : __new_sz);
+    _Pools::deallocate(__owner, __p, __old_sz);
+    return __result;
+  }
+
+#   ifdef __STL_NODE_ALLOC_TRIM
+  static size_t trim() { return _Pools::trim(); }
+#   endif
+
+#   ifdef __STL_ALLOC_STATS
+  // Small blocks freed whose chunk the map did not know; each went to
+  // the current node's pool.  A rising count means lost locality.
+  static size_t unmapped_frees() { return _S_unmapped; }
+#   endif
+
+private:
+#   ifdef __STL_ALLOC_STATS
+  static size_t __STL_VOLATILE _S_unmapped;
+#   endif
+
+  // The node whose pool owns the block of __n bytes at __p.  Blocks
+  // above _MAX_BYTES come from malloc_alloc and any pool frees them.
+  static int _S_owner(void* __p, size_t __n)
+  {
+    if (__n > (size_t) _SizeClasses::_MAX_BYTES)
+      return current_node();
+    int __node = __numa_chunk_map<_ChunkSource>::_S_owner(__p);
+    if (__node >= 0)
+      return __node;
+#   ifdef __STL_ALLOC_STATS
+#     ifdef __GNUC__
+    __sync_fetch_and_add(&_S_unmapped, 1);
+#     else
+    ++_S_unmapped;
+#     endif
+#   endif
+    return current_node();
+  }
+};
+
+#   ifdef __STL_ALLOC_STATS
+template <bool threads, int inst, class _SizeClasses, class _ChunkSource>
+size_t __STL_VOLATILE
+__numa_alloc_template<threads, inst, _SizeClasses, _ChunkSource>
+  ::_S_unmapped = 0;
+#   endif
+# endif /* __STL_NODE_ALLOC_NUMA */
+
+//գʱڵһν
+// __chain_dealloc<_Alloc>::_S_deallocate frees a chain of __nobjs
+// blocks of __n bytes, linked through their first words as for
+// deallocate_chain.  Allocators without a bulk path free the blocks
+// one by one; the node allocators splice the whole chain.
+template <class _Alloc>
+struct __chain_dealloc {
+  static void _S_deallocate(void* __first, void*, size_t __n, size_t __nobjs)
+  {
+    void* __p = __first;
+    for ( ; __nobjs > 0; --__nobjs) {
+      void* __next = *(void**)__p;//ȡһ飬deallocateܸд
+      _Alloc::deallocate(__p, __n);
+      __p = __next;
+    }
+  }
+};
+
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+struct __chain_dealloc<__default_alloc_template<__threads, __inst,
+                                                _SizeClasses, _ChunkSource> > {
+  static void _S_deallocate(void* __first, void* __last, size_t __n,
+                            size_t __nobjs)
+  {
+    __default_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>
+      ::deallocate_chain(__first, __last, __n, __nobjs);
+  }
+};
+
+# ifdef __STL_NODE_ALLOC_NUMA
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+struct __chain_dealloc<__numa_alloc_template<__threads, __inst,
+                                             _SizeClasses, _ChunkSource> > {
+  static void _S_deallocate(void* __first, void* __last, size_t __n,
+                            size_t __nobjs)
+  {
+    __numa_alloc_template<__threads, __inst, _SizeClasses, _ChunkSource>
+      ::deallocate_chain(__first, __last, __n, __nobjs);
+  }
+};
+# endif /* __STL_NODE_ALLOC_NUMA */
+
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
+// Entry point for containers, whose static allocator is always a
+// simple_alloc.  The chain holds __nobjs objects of type _Tp.
+template <class _Tp, class _Alloc>
+inline void __deallocate_chain(simple_alloc<_Tp, _Alloc>*, _Tp* __first,
+                               _Tp* __last, size_t __nobjs)
+{
+  if (0 != __nobjs)
+    __chain_dealloc<_Alloc>::_S_deallocate(__first, __last, sizeof(_Tp),
+                                           __nobjs);
+}
+
+// The same for a container holding an allocator instance, which has
+// no bulk path: the objects go back one by one.
+template <class _Allocator, class _Tp>
+inline void __deallocate_chain(_Allocator& __a, _Tp* __first, _Tp*,
+                               size_t __nobjs)
+{
+  _Tp* __p = __first;
+  for ( ; __nobjs > 0; --__nobjs) {
+    _Tp* __next = *(_Tp**)__p;
+    __a.deallocate(__p, 1);
+    __p = __next;
+  }
+}
+
+#ifdef __STL_USE_STD_ALLOCATORS
+// The standard allocators forward to a static allocator, whose bulk
+// path can be used directly.
+template <class _Tp> class allocator;
+template <class _Tp, class _Alloc> struct __allocator;
+
+template <class _Tp, class _Alloc>
+inline void __deallocate_chain(__allocator<_Tp, _Alloc>&, _Tp* __first,
+                               _Tp* __last, size_t __nobjs)
+{
+  __deallocate_chain((simple_alloc<_Tp, _Alloc>*) 0, __first, __last,
+                     __nobjs);
+}
+
+template <class _Tp>
+inline void __deallocate_chain(allocator<_Tp>&, _Tp* __first, _Tp* __last,
+                               size_t __nobjs)
+{
+  __deallocate_chain((simple_alloc<_Tp, alloc>*) 0, __first, __last,
+                     __nobjs);
+}
+#endif /* __STL_USE_STD_ALLOCATORS */
+
+//͵չvectorʱֱԭ
+// __block_realloc<_Alloc>::_S_reallocate resizes a block from __old_sz
+// to __new_sz bytes, moving its bytes if it must, or returns 0 when
+// _Alloc cannot resize blocks.  The caller then allocates, moves and
+// frees by itself.  Only objects that may be moved with memcpy can live
+// in a block handed to it.
+template <class _Alloc>
+struct __block_realloc {
+  static void* _S_reallocate(void*, size_t, size_t) { return 0; }
+};
+
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
+
+template <int __inst>
+struct __block_realloc<__malloc_alloc_template<__inst> > {
+  static void* _S_reallocate(void* __p, size_t __old_sz, size_t __new_sz)
+  {
+    return __malloc_alloc_template<__inst>::reallocate(__p, __old_sz,
+                                                       __new_sz);
+  }
+};
+
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+struct __block_realloc<__default_alloc_template<__threads, __inst,
+                                                _SizeClasses, _ChunkSource> > {
+  static void* _S_reallocate(void* __p, size_t __old_sz, size_t __new_sz)
+  {
+    return __default_alloc_template<__threads, __inst, _SizeClasses,
+                                    _ChunkSource>
+      ::reallocate(__p, __old_sz, __new_sz);
+  }
+};
+
+# ifdef __STL_NODE_ALLOC_NUMA
+template <bool __threads, int __inst, class _SizeClasses, class _ChunkSource>
+struct __block_realloc<__numa_alloc_template<__threads, __inst,
+                                             _SizeClasses, _ChunkSource> > {
+  static void* _S_reallocate(void* __p, size_t __old_sz, size_t __new_sz)
+  {
+    return __numa_alloc_template<__threads, __inst, _SizeClasses,
+                                 _ChunkSource>
+      ::reallocate(__p, __old_sz, __new_sz);
+  }
+};
+# endif /* __STL_NODE_ALLOC_NUMA */
+
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
+// Entry points for containers, shaped like __deallocate_chain.  They
+// return the resized block of __new_n objects, or 0.
+template <class _Tp, class _Alloc>
+inline _Tp* __reallocate_block(simple_alloc<_Tp, _Alloc>*, _Tp* __p,
+                               size_t __old_n, size_t __new_n)
+{
+  return (_Tp*) __block_realloc<_Alloc>::_S_reallocate(
+                  __p, __old_n * sizeof(_Tp), __new_n * sizeof(_Tp));
+}
+
+template <class _Allocator, class _Tp>
+inline _Tp* __reallocate_block(_Allocator&, _Tp*, size_t, size_t)
+{
+  return 0;
+}
+
+#ifdef __STL_USE_STD_ALLOCATORS
+template <class _Tp, class _Alloc>
+inline _Tp* __reallocate_block(__allocator<_Tp, _Alloc>&, _Tp* __p,
+                               size_t __old_n, size_t __new_n)
+{
+  return __reallocate_block((simple_alloc<_Tp, _Alloc>*) 0, __p, __old_n,
+                            __new_n);
+}
+
+template <class _Tp>
+inline _Tp* __reallocate_block(allocator<_Tp>&, _Tp* __p, size_t __old_n,
+                               size_t __new_n)
+{
+  return __reallocate_block((simple_alloc<_Tp, alloc>*) 0, __p, __old_n,
+                            __new_n);
+}
+#endif /* __STL_USE_STD_ALLOCATORS */
+
 
 
 
@@ -268,12 +1905,27 @@ __default_alloc_template<__threads, __inst>::_S_chunk_alloc(size_t __size,
         { if (threads) _S_node_allocator_lock._M_acquire_lock(); }//ȡ
 #   define __NODE_ALLOCATOR_UNLOCK \
         { if (threads) _S_node_allocator_lock._M_release_lock(); }//ͷ
+# endif
+  // The per-thread front cache is keyed with pthread_getspecific.
+# if defined(__STL_NODE_ALLOC_THREAD_CACHE) && !defined(__STL_PTHREADS)
+#   error "__STL_NODE_ALLOC_THREAD_CACHE requires __STL_PTHREADS"
+# endif
+  // The lock-free free lists are built on the gcc __sync builtins.
+# if defined(__STL_NODE_ALLOC_LOCK_FREE) && !defined(__GNUC__)
+#   error "__STL_NODE_ALLOC_LOCK_FREE requires gcc atomic builtins"
+# endif
+  // A lock-free pop may read the link of a block whose chunk a
+  // concurrent trim has just freed.
+# if defined(__STL_NODE_ALLOC_LOCK_FREE) && defined(__STL_NODE_ALLOC_TRIM)
+#   error "__STL_NODE_ALLOC_TRIM cannot be combined with __STL_NODE_ALLOC_LOCK_FREE"
 # endif
 #else
 //  Thread-unsafe
 #   define __NODE_ALLOCATOR_LOCK
 #   define __NODE_ALLOCATOR_UNLOCK
 #   define __NODE_ALLOCATOR_THREADS false
+#   undef __STL_NODE_ALLOC_THREAD_CACHE
+#   undef __STL_NODE_ALLOC_LOCK_FREE
 #endif
 
 # ifdef __STL_THREADS
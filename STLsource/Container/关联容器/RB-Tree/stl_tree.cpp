@@ -545,6 +545,9 @@ protected:
     { return _M_node_allocator.allocate(1); }
   void _M_put_node(_Rb_tree_node<_Tp>* __p) //ͷһڵռ
     { _M_node_allocator.deallocate(__p, 1); }
+  void _M_put_node_chain(_Rb_tree_node<_Tp>* __first,
+                         _Rb_tree_node<_Tp>* __last, size_t __n)
+    { __deallocate_chain(_M_node_allocator, __first, __last, __n); }
 };
 
 // Specialization for instanceless allocators.
@@ -566,6 +569,9 @@ protected:
     { return _Alloc_type::allocate(1); }
   void _M_put_node(_Rb_tree_node<_Tp>* __p)
     { _Alloc_type::deallocate(__p, 1); }
+  void _M_put_node_chain(_Rb_tree_node<_Tp>* __first,
+                         _Rb_tree_node<_Tp>* __last, size_t __n)//һͷ__nӵĽڵ
+    { __deallocate_chain((_Alloc_type*) 0, __first, __last, __n); }
 };
 
 //RB-Treeṹ,,̳_Rb_tree_alloc_base
@@ -607,6 +613,9 @@ protected:
     { return _Alloc_type::allocate(1); }
   void _M_put_node(_Rb_tree_node<_Tp>* __p)
     { _Alloc_type::deallocate(__p, 1); }
+  void _M_put_node_chain(_Rb_tree_node<_Tp>* __first,
+                         _Rb_tree_node<_Tp>* __last, size_t __n)//һͷ__nӵĽڵ
+    { __deallocate_chain((_Alloc_type*) 0, __first, __last, __n); }
 };
 
 #endif /* __STL_USE_STD_ALLOCATORS */
@@ -638,6 +647,7 @@ protected:
 #ifdef __STL_USE_NAMESPACES
   using _Base::_M_get_node;
   using _Base::_M_put_node;
+  using _Base::_M_put_node_chain;
   using _Base::_M_header;//ָڵĽڵָ
 #endif /* __STL_USE_NAMESPACES */
 
@@ -1241,12 +1251,30 @@ void _Rb_tree<_Key,_Value,_KeyOfValue,_Compare,_Alloc>
   ::_M_erase(_Link_type __x)
 {
                                 // erase without rebalancing
+  // Rotating each left child up flattens the subtree as it goes, so
+  // no recursion is needed.  Destroyed nodes are strung together
+  // through their first words and freed as one chain.
+  _Link_type __first = 0;
+  _Link_type __last = 0;
+  size_t __n = 0;
   while (__x != 0) {
-    _M_erase(_S_right(__x));
     _Link_type __y = _S_left(__x);
-    destroy_node(__x);
-    __x = __y;
+    if (__y != 0) {//ӽڵ
+      __x->_M_left = __y->_M_right;
+      __y->_M_right = __x;
+      __x = __y;
+    } else {//ûͷŵǰڵ㣬ת
+      __y = _S_right(__x);
+      destroy(&__x->_M_value_field);
+      *(void**)__x = __first;//յ
+      if (__first == 0)
+        __last = __x;
+      __first = __x;
+      ++__n;
+      __x = __y;
+    }
   }
+  _M_put_node_chain(__first, __last, __n);
 }
 
 template <class _Key, class _Value, class _KeyOfValue, 
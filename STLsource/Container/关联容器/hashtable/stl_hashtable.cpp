@@ -275,6 +275,8 @@ private:
   typename _Alloc_traits<_Node, _Alloc>::allocator_type _M_node_allocator;
   _Node* _M_get_node() { return _M_node_allocator.allocate(1); }
   void _M_put_node(_Node* __p) { _M_node_allocator.deallocate(__p, 1); }
+  void _M_put_node_chain(_Node* __first, _Node* __last, size_t __n)
+    { __deallocate_chain(_M_node_allocator, __first, __last, __n); }
 # define __HASH_ALLOC_INIT(__a) _M_node_allocator(__a), 
 #else /* __STL_USE_STD_ALLOCATORS */
 public:
@@ -284,6 +286,8 @@ private:
   typedef simple_alloc<_Node, _Alloc> _M_node_allocator_type;
   _Node* _M_get_node() { return _M_node_allocator_type::allocate(1); }
   void _M_put_node(_Node* __p) { _M_node_allocator_type::deallocate(__p, 1); }
+  void _M_put_node_chain(_Node* __first, _Node* __last, size_t __n)
+    { __deallocate_chain((_M_node_allocator_type*) 0, __first, __last, __n); }
 # define __HASH_ALLOC_INIT(__a)
 #endif /* __STL_USE_STD_ALLOCATORS */
 
@@ -1121,15 +1125,24 @@ void hashtable<_Val,_Key,_HF,_Ex,_Eq,_All>
 template <class _Val, class _Key, class _HF, class _Ex, class _Eq, class _All>
 void hashtable<_Val,_Key,_HF,_Ex,_Eq,_All>::clear()
 {
+  _Node* __first = 0;//ͰӵĽڵ㴮һһͷ
+  _Node* __last = 0;
+  size_t __n = 0;
   for (size_type __i = 0; __i < _M_buckets.size(); ++__i) {//ÿͰ
     _Node* __cur = _M_buckets[__i];//ǰڵΪͰӵĵһڵ
-    while (__cur != 0) {//Ͱάͷÿڵ
+    while (__cur != 0) {//Ͱάÿڵ
       _Node* __next = __cur->_M_next;
-      _M_delete_node(__cur);
+      destroy(&__cur->_M_val);
+      *(void**)__cur = __first;//յ
+      if (__first == 0)
+        __last = __cur;
+      __first = __cur;
+      ++__n;
       __cur = __next;
     }
     _M_buckets[__i] = 0;//ͰΪ
   }
+  _M_put_node_chain(__first, __last, __n);
   _M_num_elements = 0;//ڵΪ0
 }
 
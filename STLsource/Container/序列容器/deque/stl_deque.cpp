@@ -45,6 +45,7 @@
  * parameter so users could control the node size.  This extension
  * turns out to violate the C++ standard (it can be detected using
  * template template parameters), and it has been removed.
+ * The node size is now a policy instead: see __deque_buffer below.
  */
 
 __STL_BEGIN_NAMESPACE 
@@ -62,10 +63,34 @@ __STL_BEGIN_NAMESPACE
 // Note: this function is simply a kludge to work around several compilers'
 //  bugs in handling constant expressions.
 //Ƿ㲻ͬʽbug
-inline size_t __deque_buf_size(size_t __size) {
-  return __size < 512 ? size_t(512 / __size) : size_t(1);
+//ÿԼ__bytesֽڣһԪ
+inline size_t __deque_buf_size(size_t __bytes, size_t __size) {
+  return __size < __bytes ? size_t(__bytes / __size) : size_t(1);
 }
 
+#ifndef __STL_DEQUE_BUF_BYTES
+# define __STL_DEQUE_BUF_BYTES 512
+#endif
+
+// The number of elements in each buffer of a deque<_Tp>.  Define
+// __STL_DEQUE_BUF_BYTES to change the buffer size of every deque, or
+// specialize this for one element type, e.g.
+//   template <> struct __deque_buffer<_Message>
+//     : public __deque_buffer_elems<16> {};
+// so that large objects no longer get a buffer each.  It depends on
+// _Tp alone because the iterators, which know nothing of the
+// allocator, need it too.
+template <size_t __n>
+struct __deque_buffer_elems {
+  static size_t _S_size() { return __n; }
+};
+
+template <class _Tp>
+struct __deque_buffer {
+  static size_t _S_size()
+    { return __deque_buf_size(__STL_DEQUE_BUF_BYTES, sizeof(_Tp)); }
+};
+
 //deque
 //*dequeǷֶԿռ䣬ʱܹoperator++operator--
 //*	Ĺܣ
@@ -77,7 +102,7 @@ template <class _Tp, class _Ref, class _Ptr>
 struct _Deque_iterator {
   typedef _Deque_iterator<_Tp, _Tp&, _Tp*>             iterator;
   typedef _Deque_iterator<_Tp, const _Tp&, const _Tp*> const_iterator;
-  static size_t _S_buffer_size() { return __deque_buf_size(sizeof(_Tp)); }
+  static size_t _S_buffer_size() { return __deque_buffer<_Tp>::_S_size(); }
 
   typedef random_access_iterator_tag iterator_category;
   typedef _Tp value_type;
@@ -246,6 +271,115 @@ inline ptrdiff_t* distance_type(const _Deque_iterator<_Tp,_Ref,_Ptr>&) {
 
 #endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
 
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
+
+// The buffers are the segments of a deque iterator, so copy, fill,
+// find, accumulate and the rest run over them as pointer ranges (see
+// __segmented_traits in stl_algobase.h).
+template <class _Tp, class _Ref, class _Ptr>
+struct __segmented_traits<_Deque_iterator<_Tp,_Ref,_Ptr> > {
+  typedef __true_type _Is_segmented;
+  typedef _Deque_iterator<_Tp,_Ref,_Ptr> _Iterator;
+  typedef _Tp** _Segment;//пmapеĽڵ
+  typedef _Ptr _Local;
+
+  static _Segment _S_segment(const _Iterator& __i) { return __i._M_node; }
+  static _Local _S_local(const _Iterator& __i) { return __i._M_cur; }
+  static _Local _S_begin(_Segment __s) { return *__s; }
+  static _Local _S_end(_Segment __s)
+    { return *__s + _Iterator::_S_buffer_size(); }
+};
+
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
+// Batch construction and destruction over deque iterators, one buffer
+// at a time, so the inner loops run over plain pointers instead of
+// stepping a _Deque_iterator element by element.
+
+template <class _Tp, class _Ref, class _Ptr>
+inline void _Destroy(_Deque_iterator<_Tp,_Ref,_Ptr> __first,
+                     _Deque_iterator<_Tp,_Ref,_Ptr> __last)
+{
+  typedef typename __type_traits<_Tp>::has_trivial_destructor
+          _Trivial_destructor;
+  __destroy_segments(__first, __last, _Trivial_destructor());
+}
+
+template <class _Tp, class _Ref, class _Ptr>
+inline void __destroy_segments(_Deque_iterator<_Tp,_Ref,_Ptr>,
+                               _Deque_iterator<_Tp,_Ref,_Ptr>, __true_type) {}
+
+template <class _Tp, class _Ref, class _Ptr>
+void __destroy_segments(_Deque_iterator<_Tp,_Ref,_Ptr> __first,
+                        _Deque_iterator<_Tp,_Ref,_Ptr> __last, __false_type)
+{
+  if (__first._M_node == __last._M_node) {//ͬһ
+    _Destroy(__first._M_cur, __last._M_cur);
+    return;
+  }
+  _Destroy(__first._M_cur, __first._M_last);
+  for (_Tp** __node = __first._M_node + 1; __node < __last._M_node; ++__node)
+    _Destroy(*__node, *__node + __first._S_buffer_size());//м
+  _Destroy(__last._M_first, __last._M_cur);
+}
+
+template <class _Tp, class _Ref, class _Ptr, class _Size>
+inline void _Destroy_n(_Deque_iterator<_Tp,_Ref,_Ptr> __first, _Size __n)
+{
+  _Destroy(__first, __first + ptrdiff_t(__n));
+}
+
+// Each buffer is filled by uninitialized_fill_n, which takes the
+// vectorized path for POD types and undoes its own buffer if a copy
+// throws; the buffers already filled are then destroyed here.
+template <class _Tp, class _Ref, class _Ptr, class _Size, class _Tp1>
+_Deque_iterator<_Tp,_Ref,_Ptr>
+_Construct_n(_Deque_iterator<_Tp,_Ref,_Ptr> __first, _Size __n,
+             const _Tp1& __value)
+{
+  _Deque_iterator<_Tp,_Ref,_Ptr> __cur = __first;
+  __STL_TRY {
+    while (__n > 0) {
+      ptrdiff_t __room = __cur._M_last - __cur._M_cur;//ʣλ
+      ptrdiff_t __k = ptrdiff_t(__n) < __room ? ptrdiff_t(__n) : __room;
+      uninitialized_fill_n(__cur._M_cur, __k, __value);
+      __cur += __k;
+      __n -= __k;
+    }
+    return __cur;
+  }
+  __STL_UNWIND(_Destroy(__first, __cur));
+}
+
+template <class _Tp, class _Ref, class _Ptr, class _Size>
+_Deque_iterator<_Tp,_Ref,_Ptr>
+_Construct_n(_Deque_iterator<_Tp,_Ref,_Ptr> __first, _Size __n)
+{
+  _Deque_iterator<_Tp,_Ref,_Ptr> __cur = __first;
+  __STL_TRY {
+    while (__n > 0) {
+      ptrdiff_t __room = __cur._M_last - __cur._M_cur;
+      ptrdiff_t __k = ptrdiff_t(__n) < __room ? ptrdiff_t(__n) : __room;
+      _Construct_n(__cur._M_cur, __k);
+      __cur += __k;
+      __n -= __k;
+    }
+    return __cur;
+  }
+  __STL_UNWIND(_Destroy(__first, __cur));
+}
+
+// Blocks freed by pop_front/pop_back are kept, up to this many, and
+// handed out again by the next push that needs a block, so a deque used
+// as a FIFO queue stops allocating once it reaches a steady state.
+// Must be at least 1.
+#ifndef __STL_DEQUE_SPARE_NODES
+# define __STL_DEQUE_SPARE_NODES 2
+#endif
+#if __STL_DEQUE_SPARE_NODES < 1
+# error "__STL_DEQUE_SPARE_NODES must be at least 1"
+#endif
+
 // Deque base class.  It has two purposes.  First, its constructor
 //  and destructor allocate (but don't initialize) storage.  This makes
 //  exception safety easier.  Second, the base class encapsulates all of
@@ -275,10 +409,10 @@ protected:
   _Map_allocator_type _M_map_allocator;
 
   _Tp* _M_allocate_node() {
-    return _M_node_allocator.allocate(__deque_buf_size(sizeof(_Tp)));
+    return _M_node_allocator.allocate(__deque_buffer<_Tp>::_S_size());
   }
   void _M_deallocate_node(_Tp* __p) {
-    _M_node_allocator.deallocate(__p, __deque_buf_size(sizeof(_Tp)));
+    _M_node_allocator.deallocate(__p, __deque_buffer<_Tp>::_S_size());
   }
   _Tp** _M_allocate_map(size_t __n) 
     { return _M_map_allocator.allocate(__n); }
@@ -304,10 +438,10 @@ protected:
   typedef typename _Alloc_traits<_Tp*, _Alloc>::_Alloc_type _Map_alloc_type;
 
   _Tp* _M_allocate_node() {
-    return _Node_alloc_type::allocate(__deque_buf_size(sizeof(_Tp)));
+    return _Node_alloc_type::allocate(__deque_buffer<_Tp>::_S_size());
   }
   void _M_deallocate_node(_Tp* __p) {
-    _Node_alloc_type::deallocate(__p, __deque_buf_size(sizeof(_Tp)));
+    _Node_alloc_type::deallocate(__p, __deque_buffer<_Tp>::_S_size());
   }
   _Tp** _M_allocate_map(size_t __n) 
     { return _Map_alloc_type::allocate(__n); }
@@ -333,10 +467,10 @@ public:
 
   //__num_elementsʾ(ڵ)洢Ԫصĸ
   _Deque_base(const allocator_type& __a, size_t __num_elements)
-    : _Base(__a), _M_start(), _M_finish()
+    : _Base(__a), _M_spare_count(0), _M_start(), _M_finish()
     { _M_initialize_map(__num_elements); }
   _Deque_base(const allocator_type& __a) 
-    : _Base(__a), _M_start(), _M_finish() {}
+    : _Base(__a), _M_spare_count(0), _M_start(), _M_finish() {}
   ~_Deque_base();    
 
 protected:
@@ -345,6 +479,27 @@ protected:
   void _M_destroy_nodes(_Tp** __nstart, _Tp** __nfinish);
   enum { _S_initial_map_size = 8 };//пmapĬϴС
 
+  //ȴӱýڵȡûʱ
+  _Tp* _M_allocate_node() {
+    if (_M_spare_count != 0)
+      return _M_spare_nodes[--_M_spare_count];
+    return _Base::_M_allocate_node();
+  }
+  void _M_deallocate_node(_Tp* __p) {
+    if (_M_spare_count < (size_t) _S_max_spare_nodes)
+      _M_spare_nodes[_M_spare_count++] = __p;
+    else
+      _Base::_M_deallocate_node(__p);
+  }
+  void _M_release_spare_nodes() {
+    while (_M_spare_count != 0)
+      _Base::_M_deallocate_node(_M_spare_nodes[--_M_spare_count]);
+  }
+
+  enum { _S_max_spare_nodes = __STL_DEQUE_SPARE_NODES };
+  _Tp* _M_spare_nodes[_S_max_spare_nodes];//յĻ´ʹ
+  size_t _M_spare_count;
+
 protected:
   iterator _M_start;//ָһĵһԪ
   iterator _M_finish;//ָһһԪصһλ
@@ -362,11 +517,13 @@ public:
   allocator_type get_allocator() const { return allocator_type(); }
 
   _Deque_base(const allocator_type&, size_t __num_elements)
-    : _M_map(0), _M_map_size(0),  _M_start(), _M_finish() {
+    : _M_map(0), _M_map_size(0), _M_spare_count(0),
+      _M_start(), _M_finish() {
     _M_initialize_map(__num_elements);
   }
   _Deque_base(const allocator_type&)
-    : _M_map(0), _M_map_size(0),  _M_start(), _M_finish() {}
+    : _M_map(0), _M_map_size(0), _M_spare_count(0),
+      _M_start(), _M_finish() {}
   ~_Deque_base();    
 
 protected:
@@ -376,18 +533,34 @@ protected:
   enum { _S_initial_map_size = 8 };
 
 protected:
+  enum { _S_max_spare_nodes = __STL_DEQUE_SPARE_NODES };
+
   _Tp** _M_map;
   size_t _M_map_size;  
+  _Tp* _M_spare_nodes[_S_max_spare_nodes];
+  size_t _M_spare_count;
   iterator _M_start;
   iterator _M_finish;
 
   typedef simple_alloc<_Tp, _Alloc>  _Node_alloc_type;
   typedef simple_alloc<_Tp*, _Alloc> _Map_alloc_type;
 
-  _Tp* _M_allocate_node()
-    { return _Node_alloc_type::allocate(__deque_buf_size(sizeof(_Tp))); }
-  void _M_deallocate_node(_Tp* __p)
-    { _Node_alloc_type::deallocate(__p, __deque_buf_size(sizeof(_Tp))); }
+  _Tp* _M_allocate_node() {
+    if (_M_spare_count != 0)
+      return _M_spare_nodes[--_M_spare_count];
+    return _Node_alloc_type::allocate(__deque_buffer<_Tp>::_S_size());
+  }
+  void _M_deallocate_node(_Tp* __p) {
+    if (_M_spare_count < (size_t) _S_max_spare_nodes)
+      _M_spare_nodes[_M_spare_count++] = __p;
+    else
+      _Node_alloc_type::deallocate(__p, __deque_buffer<_Tp>::_S_size());
+  }
+  void _M_release_spare_nodes() {
+    while (_M_spare_count != 0)
+      _Node_alloc_type::deallocate(_M_spare_nodes[--_M_spare_count],
+                                   __deque_buffer<_Tp>::_S_size());
+  }
   _Tp** _M_allocate_map(size_t __n) 
     { return _Map_alloc_type::allocate(__n); }
   void _M_deallocate_map(_Tp** __p, size_t __n) 
@@ -404,6 +577,7 @@ _Deque_base<_Tp,_Alloc>::~_Deque_base() {
     _M_destroy_nodes(_M_start._M_node, _M_finish._M_node + 1);
     _M_deallocate_map(_M_map, _M_map_size);
   }
+  _M_release_spare_nodes();
 }
 
 template <class _Tp, class _Alloc>
@@ -412,7 +586,7 @@ _Deque_base<_Tp,_Alloc>::_M_initialize_map(size_t __num_elements)
 {
    //ݴ洢ԪظͻСпmap
 	size_t __num_nodes = 
-		__num_elements / __deque_buf_size(sizeof(_Tp)) + 1;
+		__num_elements / __deque_buffer<_Tp>::_S_size() + 1;
 
   //ĬֵͼֵУȡ
 	//mapĽڵ㣬8ڵ2
@@ -434,7 +608,7 @@ _Deque_base<_Tp,_Alloc>::_M_initialize_map(size_t __num_elements)
   _M_start._M_cur = _M_start._M_first;//ʼstart.cur,ʹָһĵһԪ
   //ʼfinish.cur,ʹָһһԪ
   _M_finish._M_cur = _M_finish._M_first +
-               __num_elements % __deque_buf_size(sizeof(_Tp));
+               __num_elements % __deque_buffer<_Tp>::_S_size();
 }
 
 //mapʵʴ洢Ľڵռ
@@ -496,7 +670,7 @@ public:                         // Iterators
 
 protected:                      // Internal typedefs
   typedef pointer* _Map_pointer;
-  static size_t _S_buffer_size() { return __deque_buf_size(sizeof(_Tp)); }
+  static size_t _S_buffer_size() { return __deque_buffer<_Tp>::_S_size(); }
 
 protected:
 	//̳лĳԱ
@@ -506,6 +680,7 @@ protected:
   using _Base::_M_destroy_nodes;
   using _Base::_M_allocate_node;
   using _Base::_M_deallocate_node;
+  using _Base::_M_release_spare_nodes;
   using _Base::_M_allocate_map;
   using _Base::_M_deallocate_map;
 
@@ -1034,7 +1209,7 @@ void deque<_Tp, _Alloc>::_M_fill_insert(iterator __pos,
   if (__pos._M_cur == _M_start._M_cur) {//ͷ
     iterator __new_start = _M_reserve_elements_at_front(__n);
     __STL_TRY {
-      uninitialized_fill(__new_start, _M_start, __x);
+      _Construct_n(__new_start, __n, __x);//
       _M_start = __new_start;
     }
     __STL_UNWIND(_M_destroy_nodes(__new_start._M_node, _M_start._M_node));
@@ -1042,7 +1217,7 @@ void deque<_Tp, _Alloc>::_M_fill_insert(iterator __pos,
   else if (__pos._M_cur == _M_finish._M_cur) {//β
     iterator __new_finish = _M_reserve_elements_at_back(__n);
     __STL_TRY {
-      uninitialized_fill(_M_finish, __new_finish, __x);
+      _Construct_n(_M_finish, __n, __x);
       _M_finish = __new_finish;
     }
     __STL_UNWIND(_M_destroy_nodes(_M_finish._M_node + 1, 
@@ -1123,7 +1298,7 @@ deque<_Tp,_Alloc>::erase(iterator __first, iterator __last)
       copy_backward(_M_start, __first, __last);
       iterator __new_start = _M_start + __n;
       destroy(_M_start, __new_start);
-      _M_destroy_nodes(__new_start._M_node, _M_start._M_node);
+      _M_destroy_nodes(_M_start._M_node, __new_start._M_node);
       _M_start = __new_start;
     }
     else {
@@ -1729,6 +1904,15 @@ void deque<_Tp,_Alloc>::_M_reallocate_map(size_type __nodes_to_add,
 }
 
 
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
+// The map and both iterators point into the heap, never into the deque
+// object itself, so a deque may be relocated with memcpy.
+template <class _Tp, class _Alloc>
+struct __relocate_traits<deque<_Tp, _Alloc> > {
+  typedef __true_type _Trivially_relocatable;
+};
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
 // Nonmember functions.
 
 template <class _Tp, class _Alloc>
@@ -305,6 +305,248 @@ sort_heap(_RandomAccessIterator __first,
     pop_heap(__first, __last--, __comp);
 }
 
+//d叉堆：每个节点有_Dp个子节点
+// d-ary heaps: make_dary_heap<_Dp>, push_dary_heap<_Dp>, pop_dary_heap<_Dp>
+// and sort_dary_heap<_Dp>, used like their binary counterparts above,
+// e.g. push_dary_heap<4>(__v.begin(), __v.end()).  Node __i has children
+// _Dp * __i + 1 through _Dp * __i + _Dp.  A heap of __n elements is then
+// log(_Dp, __n) levels deep instead of log(2, __n), and the _Dp children
+// a sift-down compares are adjacent in memory, so with _Dp = 4 or 8 and
+// small elements each level costs one cache miss rather than one per
+// comparison.  make_dary_heap and push get much cheaper.  pop trades
+// fewer levels for more comparisons per level: it loses to the binary
+// heap while the heap fits in the cache and breaks even beyond it.
+// A range is a d-ary heap only for the _Dp it was built with.
+
+template <int _Dp, class _RandomAccessIterator, class _Distance, class _Tp,
+          class _Compare>
+void
+__dary_push_heap(_RandomAccessIterator __first, _Distance __holeIndex,
+                 _Distance __topIndex, _Tp __value, _Compare __comp)
+{
+  _Distance __parent = (__holeIndex - 1) / _Dp;
+  while (__holeIndex > __topIndex && __comp(*(__first + __parent), __value)) {
+    *(__first + __holeIndex) = *(__first + __parent);
+    __holeIndex = __parent;
+    __parent = (__holeIndex - 1) / _Dp;
+  }
+  *(__first + __holeIndex) = __value;
+}
+
+// As __adjust_heap: moves the hole down to a leaf along the largest
+// children, then lets __value rise from there.
+template <int _Dp, class _RandomAccessIterator, class _Distance, class _Tp,
+          class _Compare>
+void
+__dary_adjust_heap(_RandomAccessIterator __first, _Distance __holeIndex,
+                   _Distance __len, _Tp __value, _Compare __comp)
+{
+  _Distance __topIndex = __holeIndex;
+  _Distance __child = _Dp * __holeIndex + 1;//第一个子节点
+  while (__child < __len) {
+    _Distance __last = __len - __child > _Dp ? __child + _Dp : __len;
+    _Distance __largest = __child;//找出最大的子节点
+    for (_Distance __i = __child + 1; __i < __last; ++__i)
+      if (__comp(*(__first + __largest), *(__first + __i)))
+        __largest = __i;
+    *(__first + __holeIndex) = *(__first + __largest);
+    __holeIndex = __largest;
+    __child = _Dp * __holeIndex + 1;
+  }
+  __dary_push_heap<_Dp>(__first, __holeIndex, __topIndex, __value, __comp);
+}
+
+template <int _Dp, class _RandomAccessIterator, class _Compare,
+          class _Distance, class _Tp>
+inline void
+__push_dary_heap_aux(_RandomAccessIterator __first,
+                     _RandomAccessIterator __last, _Compare __comp,
+                     _Distance*, _Tp*)
+{
+  __dary_push_heap<_Dp>(__first, _Distance((__last - __first) - 1),
+                        _Distance(0), _Tp(*(__last - 1)), __comp);
+}
+
+template <int _Dp, class _RandomAccessIterator, class _Compare>
+inline void
+push_dary_heap(_RandomAccessIterator __first, _RandomAccessIterator __last,
+               _Compare __comp)
+{
+  __STL_REQUIRES(_RandomAccessIterator, _Mutable_RandomAccessIterator);
+  __push_dary_heap_aux<_Dp>(__first, __last, __comp,
+                            __DISTANCE_TYPE(__first), __VALUE_TYPE(__first));
+}
+
+template <int _Dp, class _RandomAccessIterator, class _Compare,
+          class _Distance, class _Tp>
+inline void
+__pop_dary_heap(_RandomAccessIterator __first, _RandomAccessIterator __last,
+                _Compare __comp, _Distance*, _Tp*)
+{
+  _Tp __value = *(__last - 1);
+  *(__last - 1) = *__first;
+  __dary_adjust_heap<_Dp>(__first, _Distance(0),
+                          _Distance((__last - __first) - 1), __value, __comp);
+}
+
+template <int _Dp, class _RandomAccessIterator, class _Compare>
+inline void
+pop_dary_heap(_RandomAccessIterator __first, _RandomAccessIterator __last,
+              _Compare __comp)
+{
+  __STL_REQUIRES(_RandomAccessIterator, _Mutable_RandomAccessIterator);
+  __pop_dary_heap<_Dp>(__first, __last, __comp,
+                       __DISTANCE_TYPE(__first), __VALUE_TYPE(__first));
+}
+
+template <int _Dp, class _RandomAccessIterator, class _Compare,
+          class _Distance, class _Tp>
+void
+__make_dary_heap(_RandomAccessIterator __first, _RandomAccessIterator __last,
+                 _Compare __comp, _Distance*, _Tp*)
+{
+  if (__last - __first < 2) return;
+  _Distance __len = __last - __first;
+  _Distance __parent = (__len - 2) / _Dp;//最后一个有子节点的节点
+
+  while (true) {
+    __dary_adjust_heap<_Dp>(__first, __parent, __len,
+                            _Tp(*(__first + __parent)), __comp);
+    if (__parent == 0) return;
+    __parent--;
+  }
+}
+
+template <int _Dp, class _RandomAccessIterator, class _Compare>
+inline void
+make_dary_heap(_RandomAccessIterator __first, _RandomAccessIterator __last,
+               _Compare __comp)
+{
+  __STL_REQUIRES(_RandomAccessIterator, _Mutable_RandomAccessIterator);
+  __make_dary_heap<_Dp>(__first, __last, __comp,
+                        __DISTANCE_TYPE(__first), __VALUE_TYPE(__first));
+}
+
+template <int _Dp, class _RandomAccessIterator, class _Compare>
+void
+sort_dary_heap(_RandomAccessIterator __first, _RandomAccessIterator __last,
+               _Compare __comp)
+{
+  __STL_REQUIRES(_RandomAccessIterator, _Mutable_RandomAccessIterator);
+  while (__last - __first > 1)
+    pop_dary_heap<_Dp>(__first, __last--, __comp);
+}
+
+// The versions without __comp use operator<.
+
+template <int _Dp, class _RandomAccessIterator, class _Tp>
+inline void
+__push_dary_heap_aux(_RandomAccessIterator __first,
+                     _RandomAccessIterator __last, _Tp*)
+{
+  push_dary_heap<_Dp>(__first, __last, __less_than<_Tp>());
+}
+
+template <int _Dp, class _RandomAccessIterator>
+inline void
+push_dary_heap(_RandomAccessIterator __first, _RandomAccessIterator __last)
+{
+  __STL_REQUIRES(_RandomAccessIterator, _Mutable_RandomAccessIterator);
+  __STL_REQUIRES(typename iterator_traits<_RandomAccessIterator>::value_type,
+                 _LessThanComparable);
+  __push_dary_heap_aux<_Dp>(__first, __last, __VALUE_TYPE(__first));
+}
+
+template <int _Dp, class _RandomAccessIterator, class _Tp>
+inline void
+__pop_dary_heap_aux(_RandomAccessIterator __first,
+                    _RandomAccessIterator __last, _Tp*)
+{
+  pop_dary_heap<_Dp>(__first, __last, __less_than<_Tp>());
+}
+
+template <int _Dp, class _RandomAccessIterator>
+inline void
+pop_dary_heap(_RandomAccessIterator __first, _RandomAccessIterator __last)
+{
+  __STL_REQUIRES(_RandomAccessIterator, _Mutable_RandomAccessIterator);
+  __STL_REQUIRES(typename iterator_traits<_RandomAccessIterator>::value_type,
+                 _LessThanComparable);
+  __pop_dary_heap_aux<_Dp>(__first, __last, __VALUE_TYPE(__first));
+}
+
+template <int _Dp, class _RandomAccessIterator, class _Tp>
+inline void
+__make_dary_heap_aux(_RandomAccessIterator __first,
+                     _RandomAccessIterator __last, _Tp*)
+{
+  make_dary_heap<_Dp>(__first, __last, __less_than<_Tp>());
+}
+
+template <int _Dp, class _RandomAccessIterator>
+inline void
+make_dary_heap(_RandomAccessIterator __first, _RandomAccessIterator __last)
+{
+  __STL_REQUIRES(_RandomAccessIterator, _Mutable_RandomAccessIterator);
+  __STL_REQUIRES(typename iterator_traits<_RandomAccessIterator>::value_type,
+                 _LessThanComparable);
+  __make_dary_heap_aux<_Dp>(__first, __last, __VALUE_TYPE(__first));
+}
+
+template <int _Dp, class _RandomAccessIterator, class _Tp>
+inline void
+__sort_dary_heap_aux(_RandomAccessIterator __first,
+                     _RandomAccessIterator __last, _Tp*)
+{
+  sort_dary_heap<_Dp>(__first, __last, __less_than<_Tp>());
+}
+
+template <int _Dp, class _RandomAccessIterator>
+inline void
+sort_dary_heap(_RandomAccessIterator __first, _RandomAccessIterator __last)
+{
+  __STL_REQUIRES(_RandomAccessIterator, _Mutable_RandomAccessIterator);
+  __STL_REQUIRES(typename iterator_traits<_RandomAccessIterator>::value_type,
+                 _LessThanComparable);
+  __sort_dary_heap_aux<_Dp>(__first, __last, __VALUE_TYPE(__first));
+}
+
+// Heap layouts for priority_queue's _Heap parameter.  __dary_heap<2> is
+// the binary heap above; __dary_heap<4> and __dary_heap<8> suit large
+// queues, e.g. priority_queue<int, vector<int>, less<int>,
+// __dary_heap<4> >.
+template <int _Dp>
+struct __dary_heap {
+  template <class _RandomAccessIterator, class _Compare>
+  static void _S_make(_RandomAccessIterator __first,
+                      _RandomAccessIterator __last, _Compare __comp)
+    { make_dary_heap<_Dp>(__first, __last, __comp); }
+  template <class _RandomAccessIterator, class _Compare>
+  static void _S_push(_RandomAccessIterator __first,
+                      _RandomAccessIterator __last, _Compare __comp)
+    { push_dary_heap<_Dp>(__first, __last, __comp); }
+  template <class _RandomAccessIterator, class _Compare>
+  static void _S_pop(_RandomAccessIterator __first,
+                     _RandomAccessIterator __last, _Compare __comp)
+    { pop_dary_heap<_Dp>(__first, __last, __comp); }
+};
+
+__STL_TEMPLATE_NULL
+struct __dary_heap<2> {
+  template <class _RandomAccessIterator, class _Compare>
+  static void _S_make(_RandomAccessIterator __first,
+                      _RandomAccessIterator __last, _Compare __comp)
+    { make_heap(__first, __last, __comp); }
+  template <class _RandomAccessIterator, class _Compare>
+  static void _S_push(_RandomAccessIterator __first,
+                      _RandomAccessIterator __last, _Compare __comp)
+    { push_heap(__first, __last, __comp); }
+  template <class _RandomAccessIterator, class _Compare>
+  static void _S_pop(_RandomAccessIterator __first,
+                     _RandomAccessIterator __last, _Compare __comp)
+    { pop_heap(__first, __last, __comp); }
+};
+
 #if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
 #pragma reset woff 1209
 #endif
@@ -131,6 +131,9 @@ protected:
    { return _Node_allocator.allocate(1); }
   void _M_put_node(_List_node<_Tp>* __p)
     { _Node_allocator.deallocate(__p, 1); }
+  void _M_put_node_chain(_List_node<_Tp>* __first, _List_node<_Tp>* __last,
+                         size_t __n)
+    { __deallocate_chain(_Node_allocator, __first, __last, __n); }
 
 protected:
   typename _Alloc_traits<_List_node<_Tp>, _Allocator>::allocator_type
@@ -159,6 +162,10 @@ protected:
   _List_node<_Tp>* _M_get_node() { return _Alloc_type::allocate(1); }
   //һڵռ
   void _M_put_node(_List_node<_Tp>* __p) { _Alloc_type::deallocate(__p, 1); }
+  //һλ__nĽڵ
+  void _M_put_node_chain(_List_node<_Tp>* __first, _List_node<_Tp>* __last,
+                         size_t __n)
+    { __deallocate_chain((_Alloc_type*) 0, __first, __last, __n); }
 
 protected:
 	//ڵָ
@@ -223,6 +230,10 @@ protected:
   _List_node<_Tp>* _M_get_node() { return _Alloc_type::allocate(1); }
   //һڵڴռ
   void _M_put_node(_List_node<_Tp>* __p) { _Alloc_type::deallocate(__p, 1); } 
+  //һλ__nĽڵ
+  void _M_put_node_chain(_List_node<_Tp>* __first, _List_node<_Tp>* __last,
+                         size_t __n)
+    { __deallocate_chain((_Alloc_type*) 0, __first, __last, __n); }
 
 protected:
   _List_node<_Tp>* _M_node;//Ľڵָ
@@ -237,12 +248,19 @@ _List_base<_Tp,_Alloc>::clear()
 {
  //ѡȡ_M_node->_M_nextΪǰڵ
  _List_node<_Tp>* __cur = (_List_node<_Tp>*) _M_node->_M_next;
+  _List_node<_Tp>* __first = __cur;
+  _List_node<_Tp>* __last = 0;
+  size_t __n = 0;
   while (__cur != _M_node) {//ÿһڵ
     _List_node<_Tp>* __tmp = __cur;//һڵʱ
     __cur = (_List_node<_Tp>*) __cur->_M_next;//ָһڵ
     _Destroy(&__tmp->_M_data);//ݶ
-    _M_put_node(__tmp);//սڵtmpָڴռ
+    *(void**)__tmp = __cur;//ڵָһڵ㣬ɴյ
+    __last = __tmp;
+    ++__n;
   }
+  //нڵһνֻһ
+  _M_put_node_chain(__first, __last, __n);
   //,ǰͺָ붼ָԼ
   _M_node->_M_next = _M_node;
   _M_node->_M_prev = _M_node;
@@ -695,6 +713,15 @@ public:
 //list
 //**************************************************************
 
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
+// The list header node is on the heap and nothing points back at the
+// list object, so a list may be relocated with memcpy.
+template <class _Tp, class _Alloc>
+struct __relocate_traits<list<_Tp, _Alloc> > {
+  typedef __true_type _Trivially_relocatable;
+};
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
 //**************************************************************
 //*****************ǱȽ*******************
 //**************************************************************
@@ -966,6 +993,176 @@ inline void list<_Tp, _Alloc>::reverse()
   __List_base_reverse(this->_M_node);
 }    
 
+// Sorting a long list by merging nodes touches every node once per
+// merge pass, at a cache miss each.  Large lists are instead sorted
+// through one contiguous buffer, then relinked in a single pass in the
+// new order.  For a POD _Tp the buffer holds a copy of each value with
+// a pointer to its node, so the merges compare inside the buffer;
+// otherwise it holds node pointers only.  Either way only the links
+// change, so the sort stays stable and every iterator stays valid, as
+// with the merge sort.  Lists shorter than __STL_LIST_SORT_BUFFER, and
+// lists for which the buffer cannot be allocated, keep the merge sort;
+// below that size the buffer's malloc is not worth it.
+#ifndef __STL_LIST_SORT_BUFFER
+# define __STL_LIST_SORT_BUFFER 16
+#endif
+
+template <class _Tp, class _Compare>
+struct _List_node_compare {//Ƚڵе
+  _Compare _M_comp;
+  _List_node_compare(const _Compare& __comp) : _M_comp(__comp) {}
+  bool operator()(_List_node_base* __x, _List_node_base* __y) {
+    return _M_comp(((_List_node<_Tp>*) __x)->_M_data,
+                   ((_List_node<_Tp>*) __y)->_M_data);
+  }
+};
+
+template <class _Tp>
+struct _List_sort_entry {//ֵĸڽڵ
+  _Tp _M_data;
+  _List_node_base* _M_node;
+};
+
+template <class _Tp, class _Compare>
+struct _List_entry_compare {
+  _Compare _M_comp;
+  _List_entry_compare(const _Compare& __comp) : _M_comp(__comp) {}
+  bool operator()(const _List_sort_entry<_Tp>& __x,
+                  const _List_sort_entry<_Tp>& __y) {
+    return _M_comp(__x._M_data, __y._M_data);
+  }
+};
+
+// Stable merge sort of the __n entries at __a, with __b as scratch
+// space for as many.  Runs of _S_run entries are insertion sorted in
+// place, then merged pairwise from one array into the other and back.
+// Returns the array that ends up holding the result.  The entries are
+// pointers or PODs, so they are copied freely and nothing needs undoing
+// if __comp throws.  This keeps <list> from needing stable_sort and the
+// temporary buffer from <stl_algo.h>.
+template <class _Entry, class _Compare>
+_Entry* __List_buffer_sort(_Entry* __a, _Entry* __b, size_t __n,
+                           _Compare __comp)
+{
+  const size_t _S_run = 8;
+  size_t __i, __j, __k;
+
+  for (__i = 0; __i < __n; __i += _S_run) {//ÿ_S_runһΣ
+    size_t __end = __n - __i < _S_run ? __n : __i + _S_run;
+    for (__j = __i + 1; __j < __end; ++__j) {
+      _Entry __v = __a[__j];
+      for (__k = __j; __k > __i && __comp(__v, __a[__k - 1]); --__k)
+        __a[__k] = __a[__k - 1];
+      __a[__k] = __v;
+    }
+  }
+  for (size_t __w = _S_run; __w < __n; __w *= 2) {//ι鲢һ
+    for (__i = 0; __i < __n; __i += 2 * __w) {
+      size_t __mid = __n - __i < __w ? __n : __i + __w;
+      size_t __end = __n - __mid < __w ? __n : __mid + __w;
+      __j = __i;
+      __k = __mid;
+      _Entry* __out = __b + __i;
+      while (__j < __mid && __k < __end)//ʱȡǰһεģȶ
+        *__out++ = __comp(__a[__k], __a[__j]) ? __a[__k++] : __a[__j++];
+      while (__j < __mid)
+        *__out++ = __a[__j++];
+      while (__k < __end)
+        *__out++ = __a[__k++];
+    }
+    _Entry* __tmp = __a;
+    __a = __b;
+    __b = __tmp;
+  }
+  return __a;
+}
+
+// By value: a POD copies and compares without touching the nodes.
+template <class _Tp, class _Compare>
+bool __List_base_sort_buffered_aux(_List_node_base* __head, size_t __n,
+                                   _Compare __comp, _Tp*, __true_type)
+{
+  _List_sort_entry<_Tp>* __buf = (_List_sort_entry<_Tp>*)
+    malloc(2 * __n * sizeof(_List_sort_entry<_Tp>));//һ鲢ݴ
+  if (0 == __buf)
+    return false;
+
+  _List_sort_entry<_Tp>* __q = __buf;
+  _List_sort_entry<_Tp>* __sorted;
+  _List_node_base* __p;
+  for (__p = __head->_M_next; __p != __head; __p = __p->_M_next, ++__q) {
+    __q->_M_data = ((_List_node<_Tp>*) __p)->_M_data;
+    __q->_M_node = __p;
+  }
+  __STL_TRY {
+    __sorted = __List_buffer_sort(__buf, __buf + __n, __n,
+                                  _List_entry_compare<_Tp, _Compare>(__comp));
+  }
+  __STL_UNWIND(free(__buf));
+
+  _List_node_base* __prev = __head;//˳
+  for (__q = __sorted; __q != __sorted + __n; ++__q) {
+    __prev->_M_next = __q->_M_node;
+    __q->_M_node->_M_prev = __prev;
+    __prev = __q->_M_node;
+  }
+  __prev->_M_next = __head;
+  __head->_M_prev = __prev;
+  free(__buf);
+  return true;
+}
+
+// By node pointer.
+template <class _Tp, class _Compare>
+bool __List_base_sort_buffered_aux(_List_node_base* __head, size_t __n,
+                                   _Compare __comp, _Tp*, __false_type)
+{
+  _List_node_base** __buf =
+    (_List_node_base**) malloc(2 * __n * sizeof(_List_node_base*));
+  if (0 == __buf)
+    return false;
+
+  _List_node_base** __q = __buf;
+  _List_node_base** __sorted;
+  _List_node_base* __p;
+  for (__p = __head->_M_next; __p != __head; __p = __p->_M_next)
+    *__q++ = __p;
+  __STL_TRY {
+    __sorted = __List_buffer_sort(__buf, __buf + __n, __n,
+                                  _List_node_compare<_Tp, _Compare>(__comp));
+  }
+  __STL_UNWIND(free(__buf));
+
+  _List_node_base* __prev = __head;
+  for (__q = __sorted; __q != __sorted + __n; ++__q) {
+    __prev->_M_next = *__q;
+    (*__q)->_M_prev = __prev;
+    __prev = *__q;
+  }
+  __prev->_M_next = __head;
+  __head->_M_prev = __prev;
+  free(__buf);
+  return true;
+}
+
+// Sorts the list headed by __head through a buffer.  Returns false,
+// leaving the list untouched, if the list is short or the buffer cannot
+// be had; the caller then merge sorts.
+template <class _Tp, class _Compare>
+bool __List_base_sort_buffered(_List_node_base* __head, _Compare __comp,
+                               _Tp*)
+{
+  size_t __n = 0;
+  for (_List_node_base* __p = __head->_M_next; __p != __head;
+       __p = __p->_M_next)
+    ++__n;
+  if (__n < __STL_LIST_SORT_BUFFER)
+    return false;
+  typedef typename __type_traits<_Tp>::is_POD_type _Is_POD;
+  return __List_base_sort_buffered_aux(__head, __n, __comp, (_Tp*) 0,
+                                       _Is_POD());
+}
+
 //listĵʱ˫
 //ΪSTL㷨sort()ǽʵﲢʺ
 template <class _Tp, class _Alloc>
@@ -974,6 +1171,8 @@ void list<_Tp, _Alloc>::sort()
   // Do nothing if the list has length 0 or 1.
   if (_M_node->_M_next != _M_node && _M_node->_M_next->_M_next != _M_node) 
   {
+    if (__List_base_sort_buffered(_M_node, __less_than<_Tp>(), (_Tp*) 0))
+      return;
     list<_Tp, _Alloc> __carry;//carry𵽰˵
 	//counterм洢
 	/*
@@ -1063,6 +1262,8 @@ void list<_Tp, _Alloc>::sort(_StrictWeakOrdering __comp)
 {
   // Do nothing if the list has length 0 or 1.
   if (_M_node->_M_next != _M_node && _M_node->_M_next->_M_next != _M_node) {
+    if (__List_base_sort_buffered(_M_node, __comp, (_Tp*) 0))
+      return;
     list<_Tp, _Alloc> __carry;
     list<_Tp, _Alloc> __counter[64];
     int __fill = 0;
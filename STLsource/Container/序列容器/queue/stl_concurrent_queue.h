@@ -0,0 +1,435 @@
+#ifndef __SGI_STL_INTERNAL_CONCURRENT_QUEUE_H
+#define __SGI_STL_INTERNAL_CONCURRENT_QUEUE_H
+
+//н粢Уspsc_queue(ߵ)mpmc_queue(߶)
+// Bounded queues that threads can share without a mutex, for the cases
+// where queue<_Tp, deque<_Tp> > would need one around every call.
+// Both keep their elements in a ring of capacity() slots, allocated
+// once, so push and pop never allocate.  The capacity is rounded up to
+// a power of two.  push returns false when the queue is full and
+// pop(__x) returns false when it is empty; neither blocks.
+//
+//   spsc_queue<_Tp>: exactly one thread pushes and one thread pops.
+//     push/pop are a load and a store each.  The consumer may look at
+//     front() before pop(), as with queue.
+//   mpmc_queue<_Tp>: any number of threads push and pop.  Each slot
+//     carries a sequence number that tells a producer whether it is
+//     free and a consumer whether it is filled, so a push or pop costs
+//     one compare-and-swap on the tail or the head.  There is no
+//     front(): another consumer could take the element in between,
+//     so pop(__x) hands it over instead.
+//
+// Also here, though not bounded:
+//   concurrent_priority_queue<_Tp>: any number of threads push and pop
+//     by priority, as with priority_queue.  See below.
+//
+// _Tp's copy constructor, assignment and destructor must not throw in
+// an mpmc_queue: a slot, once claimed, cannot be given back.  Slots are
+// declared with _Tp's alignment, but the ring itself is only as aligned
+// as _Alloc makes it.
+//
+// These need <atomic>, so a C++11 compiler.
+
+#include <atomic>
+
+__STL_BEGIN_NAMESPACE
+
+#ifndef __STL_CACHE_LINE_SIZE
+# define __STL_CACHE_LINE_SIZE 64
+#endif
+
+//ϵ2ݴΣ±ֻ谴λ
+inline size_t __ring_capacity(size_t __n)
+{
+  size_t __cap = 2;
+  while (__cap < __n)
+    __cap <<= 1;
+  return __cap;
+}
+
+template <class _Tp, class _Alloc = alloc>
+class spsc_queue {
+public:
+  typedef _Tp               value_type;
+  typedef size_t            size_type;
+  typedef _Tp&              reference;
+  typedef const _Tp&        const_reference;
+
+protected:
+  typedef simple_alloc<_Tp, _Alloc> _Data_allocator;
+
+  // The producer's and the consumer's counters live on cache lines of
+  // their own.  Each side also keeps a stale copy of the other's
+  // counter and rereads the real one only when the copy says the ring
+  // is full (or empty), so in the steady state neither side touches the
+  // other's line.
+  char _M_pad0[__STL_CACHE_LINE_SIZE];
+  _Tp* _M_buffer;
+  size_t _M_mask;//һ
+  char _M_pad1[__STL_CACHE_LINE_SIZE - sizeof(_Tp*) - sizeof(size_t)];
+  std::atomic<size_t> _M_tail;//дλ
+  size_t _M_head_cache;//߿λ
+  char _M_pad2[__STL_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)
+               - sizeof(size_t)];
+  std::atomic<size_t> _M_head;//߶ȡλ
+  size_t _M_tail_cache;//߿λ
+  char _M_pad3[__STL_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)
+               - sizeof(size_t)];
+
+  spsc_queue(const spsc_queue&);
+  void operator=(const spsc_queue&);
+
+public:
+  explicit spsc_queue(size_type __n)
+    : _M_buffer(0), _M_mask(__ring_capacity(__n) - 1),
+      _M_tail(0), _M_head_cache(0), _M_head(0), _M_tail_cache(0)
+    { _M_buffer = _Data_allocator::allocate(_M_mask + 1); }
+
+  ~spsc_queue() {
+    size_t __head = _M_head.load(std::memory_order_relaxed);
+    size_t __tail = _M_tail.load(std::memory_order_relaxed);
+    for ( ; __head != __tail; ++__head)
+      destroy(_M_buffer + (__head & _M_mask));
+    _Data_allocator::deallocate(_M_buffer, _M_mask + 1);
+  }
+
+  size_type capacity() const { return _M_mask + 1; }
+
+  // Exact when called by the producer or the consumer, a snapshot
+  // otherwise.
+  size_type size() const {
+    return _M_tail.load(std::memory_order_acquire)
+           - _M_head.load(std::memory_order_acquire);
+  }
+  bool empty() const { return size() == 0; }
+
+  // Producer only.
+  bool push(const value_type& __x) {
+    size_t __tail = _M_tail.load(std::memory_order_relaxed);
+    if (__tail - _M_head_cache > _M_mask) {//¶ȡλ
+      _M_head_cache = _M_head.load(std::memory_order_acquire);
+      if (__tail - _M_head_cache > _M_mask)
+        return false;
+    }
+    construct(_M_buffer + (__tail & _M_mask), __x);
+    _M_tail.store(__tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer only.  front and pop() require !empty().
+  reference front() {
+    return _M_buffer[_M_head.load(std::memory_order_relaxed) & _M_mask];
+  }
+  void pop() {
+    size_t __head = _M_head.load(std::memory_order_relaxed);
+    destroy(_M_buffer + (__head & _M_mask));
+    _M_head.store(__head + 1, std::memory_order_release);
+  }
+  bool pop(value_type& __x) {
+    size_t __head = _M_head.load(std::memory_order_relaxed);
+    if (__head == _M_tail_cache) {//Ϊգ¶ȡλ
+      _M_tail_cache = _M_tail.load(std::memory_order_acquire);
+      if (__head == _M_tail_cache)
+        return false;
+    }
+    _Tp* __p = _M_buffer + (__head & _M_mask);
+    __x = *__p;
+    destroy(__p);
+    _M_head.store(__head + 1, std::memory_order_release);
+    return true;
+  }
+};
+
+template <class _Tp, class _Alloc = alloc>
+class mpmc_queue {
+public:
+  typedef _Tp               value_type;
+  typedef size_t            size_type;
+  typedef _Tp&              reference;
+  typedef const _Tp&        const_reference;
+
+protected:
+  // Slot __i starts with sequence number __i.  A producer at position
+  // __pos may fill the slot when its number is __pos and then sets it
+  // to __pos + 1; a consumer at __pos may empty it when the number is
+  // __pos + 1 and then sets it to __pos + capacity(), which is where
+  // the next lap's producer will look for it.
+  struct _Slot {
+    std::atomic<size_t> _M_seq;
+    struct _Storage {//Ԫصԭʼ洢ռ䣬_Tp
+      alignas(_Tp) unsigned char _M_bytes[sizeof(_Tp)];
+    } _M_storage;
+
+    _Tp* _M_value() { return (_Tp*) _M_storage._M_bytes; }
+  };
+  typedef simple_alloc<_Slot, _Alloc> _Slot_allocator;
+
+  struct _Counter {//ռһcache lineļ
+    std::atomic<size_t> _M_value;
+    char _M_pad[__STL_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+  };
+
+  char _M_pad0[__STL_CACHE_LINE_SIZE];
+  _Slot* _M_buffer;
+  size_t _M_mask;
+  char _M_pad1[__STL_CACHE_LINE_SIZE - sizeof(_Slot*) - sizeof(size_t)];
+  _Counter _M_tail;//һpushλ
+  _Counter _M_head;//һpopλ
+
+  mpmc_queue(const mpmc_queue&);
+  void operator=(const mpmc_queue&);
+
+public:
+  explicit mpmc_queue(size_type __n)
+    : _M_buffer(0), _M_mask(__ring_capacity(__n) - 1)
+  {
+    _M_buffer = _Slot_allocator::allocate(_M_mask + 1);
+    for (size_t __i = 0; __i <= _M_mask; ++__i)
+      new (&_M_buffer[__i]._M_seq) std::atomic<size_t>(__i);
+    _M_tail._M_value.store(0, std::memory_order_relaxed);
+    _M_head._M_value.store(0, std::memory_order_relaxed);
+  }
+
+  ~mpmc_queue() {
+    size_t __head = _M_head._M_value.load(std::memory_order_relaxed);
+    size_t __tail = _M_tail._M_value.load(std::memory_order_relaxed);
+    for ( ; __head != __tail; ++__head)
+      destroy(_M_buffer[__head & _M_mask]._M_value());
+    _Slot_allocator::deallocate(_M_buffer, _M_mask + 1);
+  }
+
+  size_type capacity() const { return _M_mask + 1; }
+
+  // A snapshot: other threads may change it at any time.
+  size_type size() const {
+    size_t __head = _M_head._M_value.load(std::memory_order_acquire);
+    size_t __tail = _M_tail._M_value.load(std::memory_order_acquire);
+    return __tail > __head ? __tail - __head : 0;
+  }
+  bool empty() const { return size() == 0; }
+
+  bool push(const value_type& __x) {
+    size_t __pos = _M_tail._M_value.load(std::memory_order_relaxed);
+    _Slot* __slot;
+    for (;;) {
+      __slot = &_M_buffer[__pos & _M_mask];
+      size_t __seq = __slot->_M_seq.load(std::memory_order_acquire);
+      ptrdiff_t __dif = (ptrdiff_t) __seq - (ptrdiff_t) __pos;
+      if (__dif == 0) {//λУռ
+        if (_M_tail._M_value.compare_exchange_weak(
+              __pos, __pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (__dif < 0)//һֵԪδȡߣ
+        return false;
+      else//ȣ¶ȡ
+        __pos = _M_tail._M_value.load(std::memory_order_relaxed);
+    }
+    construct(__slot->_M_value(), __x);
+    __slot->_M_seq.store(__pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(value_type& __x) {
+    size_t __pos = _M_head._M_value.load(std::memory_order_relaxed);
+    _Slot* __slot;
+    for (;;) {
+      __slot = &_M_buffer[__pos & _M_mask];
+      size_t __seq = __slot->_M_seq.load(std::memory_order_acquire);
+      ptrdiff_t __dif = (ptrdiff_t) __seq - (ptrdiff_t) (__pos + 1);
+      if (__dif == 0) {//λãȡ
+        if (_M_head._M_value.compare_exchange_weak(
+              __pos, __pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (__dif < 0)//δ룬Ϊ
+        return false;
+      else//ȣ¶ȡ
+        __pos = _M_head._M_value.load(std::memory_order_relaxed);
+    }
+    _Tp* __p = __slot->_M_value();
+    __x = *__p;
+    destroy(__p);
+    __slot->_M_seq.store(__pos + _M_mask + 1, std::memory_order_release);
+    return true;
+  }
+};
+
+//ÿ̶߳xorshiftѡӶ
+inline size_t __shard_random()
+{
+  static thread_local size_t __state = 0;
+  if (__state == 0)
+    __state = (size_t) &__state | 1;
+  __state ^= __state << 13;
+  __state ^= __state >> 7;
+  __state ^= __state << 17;
+  return __state;
+}
+
+// A relaxed priority queue for schedulers: many threads push, a pool of
+// threads pops.  It is a set of ordinary heaps (shards), each behind a
+// lock of its own.  push adds to a random shard it can lock at once;
+// pop looks at two random shards and takes the better of their tops.
+// No lock is ever shared by all threads, so throughput keeps rising
+// with the thread count, at the price of exactness: pop returns one of
+// the highest-priority elements, not always the highest.  The expected
+// rank of what pop returns grows with the number of shards, not with
+// size(); two to four shards per thread is a good start.
+//
+// pop(__x) stands in for top() followed by pop(): between the two,
+// another thread could take the element.  pop(__x) returns false only
+// when every shard was seen empty.  _Compare and _Tp's assignment must
+// not throw in pop.
+template <class _Tp,
+          class _Sequence __STL_DEPENDENT_DEFAULT_TMPL(vector<_Tp>),
+          class _Compare
+          __STL_DEPENDENT_DEFAULT_TMPL(less<typename _Sequence::value_type>) >
+class concurrent_priority_queue {
+public:
+  typedef typename _Sequence::value_type      value_type;
+  typedef typename _Sequence::size_type       size_type;
+  typedef          _Sequence                  container_type;
+
+protected:
+  struct _Shard {
+    std::atomic<bool> _M_locked;
+    std::atomic<size_t> _M_count;//Ԫظȡд
+    _Sequence _M_c;
+    char _M_pad[__STL_CACHE_LINE_SIZE];//ӶѲcache line
+
+    _Shard() : _M_locked(false), _M_count(0) {}
+
+    bool _M_empty() const
+      { return _M_count.load(std::memory_order_relaxed) == 0; }
+    bool _M_try_lock()
+      { return !_M_locked.exchange(true, std::memory_order_acquire); }
+    void _M_lock() {
+      while (!_M_try_lock())
+        while (_M_locked.load(std::memory_order_relaxed))
+          ;
+    }
+    void _M_unlock() { _M_locked.store(false, std::memory_order_release); }
+
+    // If push_back throws, nothing was added.  If the comparison
+    // throws inside push_heap, the last element is taken off again, so
+    // the other elements stay (priority_queue clears them all).  One
+    // that push_heap had already moved down may then be lost to a
+    // duplicate of its parent.  Either way _M_count is right before
+    // the lock is released.
+    void _M_push(const value_type& __x, _Compare& __comp) {
+      size_type __old = _M_c.size();
+      __STL_TRY {
+        _M_c.push_back(__x);
+        push_heap(_M_c.begin(), _M_c.end(), __comp);
+      }
+      __STL_UNWIND((_M_c.size() != __old ? _M_c.pop_back() : (void) 0,
+                    _M_count.store(_M_c.size(), std::memory_order_relaxed),
+                    _M_unlock()));//ֻβ
+      _M_count.store(_M_c.size(), std::memory_order_relaxed);
+    }
+    void _M_pop(value_type& __x, _Compare& __comp) {
+      __x = _M_c.front();
+      pop_heap(_M_c.begin(), _M_c.end(), __comp);
+      _M_c.pop_back();
+      _M_count.store(_M_c.size(), std::memory_order_relaxed);
+    }
+  };
+  typedef simple_alloc<_Shard, alloc> _Shard_allocator;
+
+  _Shard* _M_shards;
+  size_t _M_nshards;
+  _Compare comp;
+
+  _Shard* _M_random_shard() const
+    { return _M_shards + __shard_random() % _M_nshards; }
+
+  concurrent_priority_queue(const concurrent_priority_queue&);
+  void operator=(const concurrent_priority_queue&);
+
+public:
+  explicit concurrent_priority_queue(size_t __nshards = 16,
+                                     const _Compare& __x = _Compare())
+    : _M_shards(0), _M_nshards(__nshards ? __nshards : 1), comp(__x)
+  {
+    _M_shards = _Shard_allocator::allocate(_M_nshards);
+    for (size_t __i = 0; __i < _M_nshards; ++__i)
+      construct(_M_shards + __i);
+  }
+
+  ~concurrent_priority_queue() {
+    destroy(_M_shards, _M_shards + _M_nshards);
+    _Shard_allocator::deallocate(_M_shards, _M_nshards);
+  }
+
+  // A snapshot: other threads may change it at any time.
+  size_type size() const {
+    size_type __n = 0;
+    for (size_t __i = 0; __i < _M_nshards; ++__i)
+      __n += _M_shards[__i]._M_count.load(std::memory_order_relaxed);
+    return __n;
+  }
+  bool empty() const { return size() == 0; }
+
+  void push(const value_type& __x) {
+    _Shard* __s = _M_random_shard();
+    while (!__s->_M_try_lock())//ռþͻһӶѣȴ
+      __s = _M_random_shard();
+    __s->_M_push(__x, comp);
+    __s->_M_unlock();
+  }
+
+  bool pop(value_type& __x) {
+    for (size_t __round = 0; __round < _M_nshards; ++__round) {
+      _Shard* __a = _M_random_shard();
+      _Shard* __b = _M_random_shard();
+      if (__a == __b || __b->_M_empty())
+        __b = 0;
+      if (__a->_M_empty()) {
+        if (0 == __b)
+          continue;
+        __a = __b;
+        __b = 0;
+      }
+      if (!__a->_M_try_lock())
+        continue;
+      if (0 != __b && !__b->_M_try_lock())
+        __b = 0;
+      _Shard* __best = __a;//Ѷȼϸ
+      if (0 != __b && !__b->_M_c.empty()
+          && (__a->_M_c.empty() || comp(__a->_M_c.front(), __b->_M_c.front())))
+        __best = __b;
+      bool __found = !__best->_M_c.empty();
+      if (__found)
+        __best->_M_pop(__x, comp);
+      if (0 != __b)
+        __b->_M_unlock();
+      __a->_M_unlock();
+      if (__found)
+        return true;
+    }
+    // Random probes kept missing: the queue is empty or nearly so.
+    // Look at every shard before saying it is empty.
+    for (size_t __i = 0; __i < _M_nshards; ++__i) {
+      _Shard* __s = _M_shards + __i;
+      if (__s->_M_empty())
+        continue;
+      __s->_M_lock();
+      bool __found = !__s->_M_c.empty();
+      if (__found)
+        __s->_M_pop(__x, comp);
+      __s->_M_unlock();
+      if (__found)
+        return true;
+    }
+    return false;
+  }
+};
+
+__STL_END_NAMESPACE
+
+#endif /* __SGI_STL_INTERNAL_CONCURRENT_QUEUE_H */
+
+// Local Variables:
+// mode:C++
+// End:
@@ -123,10 +123,14 @@ operator>=(const queue<_Tp, _Sequence>& __x, const queue<_Tp, _Sequence>& __y)
 
 #endif /* __STL_FUNCTION_TMPL_PARTIAL_ORDER */
 
+// _Heap is the heap layout, from stl_heap.h: __dary_heap<2>, the binary
+// heap, by default, or __dary_heap<4> or __dary_heap<8> for queues too
+// large for the cache.
 template <class _Tp, 
           class _Sequence __STL_DEPENDENT_DEFAULT_TMPL(vector<_Tp>),
           class _Compare
-          __STL_DEPENDENT_DEFAULT_TMPL(less<typename _Sequence::value_type>) >
+          __STL_DEPENDENT_DEFAULT_TMPL(less<typename _Sequence::value_type>),
+          class _Heap = __dary_heap<2> >
 class priority_queue {
 
   // requirements:
@@ -166,18 +170,18 @@ public:
   explicit priority_queue(const _Compare& __x) :  c(), comp(__x) {}
   priority_queue(const _Compare& __x, const _Sequence& __s) 
     : c(__s), comp(__x) 
-    { make_heap(c.begin(), c.end(), comp); }
+    { _Heap::_S_make(c.begin(), c.end(), comp); }
 
 #ifdef __STL_MEMBER_TEMPLATES
   template <class _InputIterator>
   priority_queue(_InputIterator __first, _InputIterator __last) 
-    : c(__first, __last) { make_heap(c.begin(), c.end(), comp); }
+    : c(__first, __last) { _Heap::_S_make(c.begin(), c.end(), comp); }
 
   template <class _InputIterator>
   priority_queue(_InputIterator __first, 
                  _InputIterator __last, const _Compare& __x)
     : c(__first, __last), comp(__x) 
-    { make_heap(c.begin(), c.end(), comp); }
+    { _Heap::_S_make(c.begin(), c.end(), comp); }
 
   template <class _InputIterator>
   priority_queue(_InputIterator __first, _InputIterator __last,
@@ -185,24 +189,24 @@ public:
   : c(__s), comp(__x)
   { 
     c.insert(c.end(), __first, __last);
-    make_heap(c.begin(), c.end(), comp);
+    _Heap::_S_make(c.begin(), c.end(), comp);
   }
 
 #else /* __STL_MEMBER_TEMPLATES */
   priority_queue(const value_type* __first, const value_type* __last) 
-    : c(__first, __last) { make_heap(c.begin(), c.end(), comp); }
+    : c(__first, __last) { _Heap::_S_make(c.begin(), c.end(), comp); }
 
   priority_queue(const value_type* __first, const value_type* __last, 
                  const _Compare& __x) 
     : c(__first, __last), comp(__x)
-    { make_heap(c.begin(), c.end(), comp); }
+    { _Heap::_S_make(c.begin(), c.end(), comp); }
 
   priority_queue(const value_type* __first, const value_type* __last, 
                  const _Compare& __x, const _Sequence& __c)
     : c(__c), comp(__x) 
   { 
     c.insert(c.end(), __first, __last);
-    make_heap(c.begin(), c.end(), comp);
+    _Heap::_S_make(c.begin(), c.end(), comp);
   }
 #endif /* __STL_MEMBER_TEMPLATES */
 
@@ -216,22 +220,245 @@ public:
   void push(const value_type& __x) {
     __STL_TRY {
       c.push_back(__x); 
-      push_heap(c.begin(), c.end(), comp);
+      _Heap::_S_push(c.begin(), c.end(), comp);
     }
     __STL_UNWIND(c.clear());
   }
   //ȼߵԪ
   void pop() {
     __STL_TRY {
-      pop_heap(c.begin(), c.end(), comp);
+      _Heap::_S_pop(c.begin(), c.end(), comp);
       c.pop_back();
     }
     __STL_UNWIND(c.clear());
   }
+
+  // Batched operations, for event loops that push or drain many
+  // elements at a time.
+  //
+  // push_range appends [__first, __last) and then restores the heap by
+  // whichever is cheaper at worst: a sift-up per new element, up to
+  // log2(size()) comparisons each, or one make_heap over the whole
+  // queue, about 2 * size().
+#ifdef __STL_MEMBER_TEMPLATES
+  template <class _InputIterator>
+  void push_range(_InputIterator __first, _InputIterator __last) {
+    __STL_TRY {
+      size_type __old_size = c.size();
+      c.insert(c.end(), __first, __last);
+      _M_heapify_tail(__old_size);
+    }
+    __STL_UNWIND(c.clear());
+  }
+#else /* __STL_MEMBER_TEMPLATES */
+  void push_range(const value_type* __first, const value_type* __last) {
+    __STL_TRY {
+      size_type __old_size = c.size();
+      c.insert(c.end(), __first, __last);
+      _M_heapify_tail(__old_size);
+    }
+    __STL_UNWIND(c.clear());
+  }
+#endif /* __STL_MEMBER_TEMPLATES */
+
+  // Removes the min(__n, size()) highest-priority elements.  pop_into
+  // also copies them to __result, highest first, and returns the end of
+  // the output.  The popped elements pile up at the back of c, which
+  // is then shortened once.
+  void pop_n(size_type __n) {
+    __STL_TRY {
+      _M_pop_to_back(__n);
+      c.erase(c.end() - __n, c.end());
+    }
+    __STL_UNWIND(c.clear());
+  }
+
+#ifdef __STL_MEMBER_TEMPLATES
+  template <class _OutputIterator>
+  _OutputIterator pop_into(_OutputIterator __result, size_type __n) {
+    __STL_TRY {
+      _M_pop_to_back(__n);
+      __result = copy(c.rbegin(), c.rbegin() + __n, __result);//ΪȼӸߵ
+      c.erase(c.end() - __n, c.end());
+    }
+    __STL_UNWIND(c.clear());
+    return __result;
+  }
+#else /* __STL_MEMBER_TEMPLATES */
+  value_type* pop_into(value_type* __result, size_type __n) {
+    __STL_TRY {
+      _M_pop_to_back(__n);
+      __result = copy(c.rbegin(), c.rbegin() + __n, __result);
+      c.erase(c.end() - __n, c.end());
+    }
+    __STL_UNWIND(c.clear());
+    return __result;
+  }
+#endif /* __STL_MEMBER_TEMPLATES */
+
+protected:
+  // c[0, __old_size) is a heap; makes all of c one.  With k new
+  // elements, make_heap is used once k * log2(size()) > 2 * size().
+  void _M_heapify_tail(size_type __old_size) {
+    size_type __len = c.size();
+    size_type __log = 0;
+    for (size_type __n = __len; __n > 1; __n >>= 1)
+      ++__log;
+    if ((__len - __old_size) * __log > 2 * __len)//˵۸ߣؽ
+      _Heap::_S_make(c.begin(), c.end(), comp);
+    else
+      for (size_type __i = __old_size + 1; __i <= __len; ++__i)
+        _Heap::_S_push(c.begin(), c.begin() + __i, comp);
+  }
+
+  // Clamps __n to size() and moves the __n highest-priority elements
+  // to the back of c, the highest last.
+  void _M_pop_to_back(size_type& __n) {
+    if (__n > c.size())
+      __n = c.size();
+    for (size_type __i = 0; __i < __n; ++__i)
+      _Heap::_S_pop(c.begin(), c.end() - __i, comp);
+  }
 };
 
 // no equality is provided
 
+//ѰַȶУͨ޸ĻɾԪ
+// A priority queue whose elements can be found again.  push returns a
+// handle; update(__h, __x) gives that element a new value and
+// erase(__h) removes it, both in O(log n), where priority_queue would
+// need lazy deletion.  A handle stays valid until its element is
+// popped or erased; after that the handle may be reused by a later
+// push.
+//
+// The heap is the binary heap of stl_heap.h.  Each entry carries its
+// handle, and every time the sifts below move an entry they record its
+// new index in _M_pos, so a handle leads to its entry in O(1).
+template <class _Tp,
+          class _Compare __STL_DEPENDENT_DEFAULT_TMPL(less<_Tp>) >
+class addressable_priority_queue {
+public:
+  typedef _Tp               value_type;
+  typedef size_t            size_type;
+  typedef size_t            handle_type;
+  typedef const _Tp&        const_reference;
+
+protected:
+  struct _Entry {
+    _Tp _M_value;
+    handle_type _M_handle;
+    _Entry(const _Tp& __x, handle_type __h) : _M_value(__x), _M_handle(__h) {}
+  };
+
+  vector<_Entry> _M_heap;
+  vector<size_type> _M_pos;// -> _M_heapе±
+  vector<handle_type> _M_free;//õľ
+  _Compare comp;
+
+  void _M_place(size_type __i, const _Entry& __e) {
+    _M_heap[__i] = __e;
+    _M_pos[__e._M_handle] = __i;
+  }
+
+  // __push_heap, recording positions.
+  void _M_sift_up(size_type __holeIndex, size_type __topIndex, _Entry __e) {
+    size_type __parent = (__holeIndex - 1) / 2;
+    while (__holeIndex > __topIndex
+           && comp(_M_heap[__parent]._M_value, __e._M_value)) {
+      _M_place(__holeIndex, _M_heap[__parent]);
+      __holeIndex = __parent;
+      __parent = (__holeIndex - 1) / 2;
+    }
+    _M_place(__holeIndex, __e);
+  }
+
+  // __adjust_heap, recording positions.
+  void _M_adjust(size_type __holeIndex, _Entry __e) {
+    size_type __topIndex = __holeIndex;
+    size_type __len = _M_heap.size();
+    size_type __secondChild = 2 * __holeIndex + 2;
+    while (__secondChild < __len) {
+      if (comp(_M_heap[__secondChild]._M_value,
+               _M_heap[__secondChild - 1]._M_value))
+        __secondChild--;
+      _M_place(__holeIndex, _M_heap[__secondChild]);
+      __holeIndex = __secondChild;
+      __secondChild = 2 * (__secondChild + 1);
+    }
+    if (__secondChild == __len) {
+      _M_place(__holeIndex, _M_heap[__secondChild - 1]);
+      __holeIndex = __secondChild - 1;
+    }
+    _M_sift_up(__holeIndex, __topIndex, __e);
+  }
+
+  // Puts __e at index __i, which the heap no longer counts as holding
+  // anything, and moves it up or down to where it belongs.
+  void _M_fix(size_type __i, const _Entry& __e) {
+    if (__i > 0 && comp(_M_heap[(__i - 1) / 2]._M_value, __e._M_value))
+      _M_sift_up(__i, 0, __e);//ȼߣ
+    else
+      _M_adjust(__i, __e);//ȼͻ򲻱䣬³
+  }
+
+public:
+  addressable_priority_queue() {}
+  explicit addressable_priority_queue(const _Compare& __x) : comp(__x) {}
+
+  bool empty() const { return _M_heap.empty(); }
+  size_type size() const { return _M_heap.size(); }
+  const_reference top() const { return _M_heap.front()._M_value; }
+  handle_type top_handle() const { return _M_heap.front()._M_handle; }
+  //ӦԪصֵ
+  const_reference operator[](handle_type __h) const
+    { return _M_heap[_M_pos[__h]]._M_value; }
+
+  handle_type push(const value_type& __x) {
+    handle_type __h;
+    __STL_TRY {
+      if (_M_free.empty()) {
+        __h = _M_pos.size();
+        _M_pos.push_back(0);
+      }
+      else {
+        __h = _M_free.back();
+        _M_free.pop_back();
+      }
+      _M_heap.push_back(_Entry(__x, __h));
+      _M_sift_up(_M_heap.size() - 1, 0, _M_heap.back());
+    }
+    __STL_UNWIND(clear());
+    return __h;
+  }
+
+  void pop() { erase(top_handle()); }
+
+  void update(handle_type __h, const value_type& __x) {
+    __STL_TRY {
+      _M_fix(_M_pos[__h], _Entry(__x, __h));
+    }
+    __STL_UNWIND(clear());
+  }
+
+  void erase(handle_type __h) {
+    __STL_TRY {
+      _M_free.push_back(__h);
+      size_type __i = _M_pos[__h];
+      _Entry __last = _M_heap.back();
+      _M_heap.pop_back();
+      if (__i < _M_heap.size())//ĩβԪλ
+        _M_fix(__i, __last);
+    }
+    __STL_UNWIND(clear());
+  }
+
+  void clear() {
+    _M_heap.clear();
+    _M_pos.clear();
+    _M_free.clear();
+  }
+};
+
 __STL_END_NAMESPACE
 
 #endif /* __SGI_STL_INTERNAL_QUEUE_H */
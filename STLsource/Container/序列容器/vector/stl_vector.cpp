@@ -23,6 +23,47 @@ protected://
   void _M_insert_aux(iterator __position, const _Tp& __x);
   void _M_insert_aux(iterator __position);
 
+  // Reallocation.  The caller allocates __len slots at __new_start and
+  // builds the new elements in the slots where they will end up, from
+  // __new_start + (__position - _M_start) up to __gap_end.  _M_relocate
+  // then relocates the old elements around them and frees the old
+  // storage.  Building the new elements first means the old ones are
+  // untouched if that throws, and trivially relocatable elements are
+  // then moved with memcpy instead of being copied and destroyed.
+  void _M_relocate(iterator __position, iterator __new_start,
+                   iterator __gap_end, size_type __len);
+  void _M_relocate_aux(iterator __position, iterator __new_start,
+                       iterator __gap_end, size_type __len, __true_type);
+  void _M_relocate_aux(iterator __position, iterator __new_start,
+                       iterator __gap_end, size_type __len, __false_type);
+
+  // The capacity to reallocate to when __n more elements do not fit.
+  size_type _M_next_capacity(size_type __n) const {
+    typedef typename __vector_growth<_Tp, _Alloc>::_Policy _Growth;
+    const size_type __old_size = size();
+    size_type __len = _Growth::_S_grow(__old_size, __n, sizeof(_Tp));
+    return __len < __old_size + __n ? __old_size + __n : __len;
+  }
+
+  // In-place expansion.  For trivially relocatable elements, asks the
+  // allocator to resize the block to __len (realloc, which may extend
+  // it where it lies or remap its pages), so the old and new buffers
+  // need not both be alive.  Returns false if that cannot be done.
+  bool _M_expand(size_type __len) {
+    typedef typename __relocate_traits<_Tp>::_Trivially_relocatable _Trivial;
+    return _M_expand_aux(__len, _Trivial());
+  }
+  bool _M_expand_aux(size_type __len, __true_type);
+  bool _M_expand_aux(size_type, __false_type) { return false; }
+
+  // After _M_expand has moved the elements away from __old_addr, a
+  // reference to one of them must follow; any other is returned as is.
+  const _Tp& _M_rebase(const _Tp& __x, size_t __old_addr) const {
+    size_t __off = (size_t) &__x - __old_addr;
+    return __off < size() * sizeof(_Tp)
+             ? *(const _Tp*) ((const char*) _M_start + __off) : __x;
+  }
+
 public://vector
   iterator begin() { return _M_start; }//ָڴռʼַĵ
   const_iterator begin() const { return _M_start; }
@@ -65,16 +106,10 @@ public://
 #endif /* __STL_THROW_RANGE_ERRORS */
 
     void reserve(size_type __n) {//ıÿռڴС
-    if (capacity() < __n) {
-      const size_type __old_size = size();
-	  //·СΪnڴռ䣬ԭݸƵ·ռ
-      iterator __tmp = _M_allocate_and_copy(__n, _M_start, _M_finish);
-      destroy(_M_start, _M_finish);//ͷԪض
-      _M_deallocate(_M_start, _M_end_of_storage - _M_start);//ԭڴռ
-	  //ָĵַ,ΪԭָĵַѾʧЧ
-      _M_start = __tmp;
-      _M_finish = __tmp + __old_size;
-      _M_end_of_storage = _M_start + __n;
+    if (capacity() < __n && !_M_expand(__n)) {
+	  //·СΪnڴռ䣬ԭݰƵ·ռ
+      iterator __tmp = _M_allocate(__n);
+      _M_relocate(_M_finish, __tmp, __tmp + size(), __n);
     }
   }
 
@@ -413,29 +448,24 @@ vector<_Tp, _Alloc>::_M_insert_aux(iterator __position, const _Tp& __x)
     *__position = __x_copy;//x뵽ָλ
   }
   else {//ڿõڴռ,·ռ䣬ʹҪ
-    const size_type __old_size = size();//ԭڴռС
-	/*ԭʼռ䲻0·ĿռΪԭ
+	/*¿ռСԾĬΪԭ
 	*ԭʼռΪ0·ĿռΪ1
 	*/
-    const size_type __len = __old_size != 0 ? 2 * __old_size : 1;
+    const size_type __len = _M_next_capacity(1);
+    const size_type __elems_before = __position - _M_start;
+    const size_t __old_addr = (size_t) _M_start;
+    if (_M_expand(__len)) {//ԭѾ͵չתΪпÿռ
+      insert(_M_start + __elems_before, _M_rebase(__x, __old_addr));
+      return;
+    }
     iterator __new_start = _M_allocate(__len);//СΪlenڴռ
-    iterator __new_finish = __new_start;
+    iterator __gap = __new_start + __elems_before;
     __STL_TRY {
-		//[start,position)ԭʼݸƵµڴռ
-      __new_finish = uninitialized_copy(_M_start, __position, __new_start);
-      construct(__new_finish, __x);//xֵ뵽ָλ
-      ++__new_finish;
-	  //[position,finish)ԭʼʣݵµĿռ
-      __new_finish = uninitialized_copy(__position, _M_finish, __new_finish);
+      construct(__gap, __x);//Ȱx¿ռеλ
     }
-    __STL_UNWIND((destroy(__new_start,__new_finish), 
-                  _M_deallocate(__new_start,__len)));
-    destroy(begin(), end());//ԭʼ
-    _M_deallocate(_M_start, _M_end_of_storage - _M_start);//ͷԭڴռ
-	//ָĵַ
-    _M_start = __new_start;
-    _M_finish = __new_finish;
-    _M_end_of_storage = __new_start + __len;
+    __STL_UNWIND(_M_deallocate(__new_start,__len));
+	//ٰ[start,position)[position,finish)ԭʼݰƵx
+    _M_relocate(__position, __new_start, __gap + 1, __len);
   }
 }
 
@@ -450,22 +480,80 @@ vector<_Tp, _Alloc>::_M_insert_aux(iterator __position)
     *__position = _Tp();
   }
   else {
-    const size_type __old_size = size();
-    const size_type __len = __old_size != 0 ? 2 * __old_size : 1;
+    const size_type __len = _M_next_capacity(1);
+    const size_type __elems_before = __position - _M_start;
+    if (_M_expand(__len)) {
+      insert(_M_start + __elems_before);
+      return;
+    }
     iterator __new_start = _M_allocate(__len);
-    iterator __new_finish = __new_start;
+    iterator __gap = __new_start + __elems_before;
     __STL_TRY {
-      __new_finish = uninitialized_copy(_M_start, __position, __new_start);
-      construct(__new_finish);
-      ++__new_finish;
-      __new_finish = uninitialized_copy(__position, _M_finish, __new_finish);
+      construct(__gap);
     }
-    __STL_UNWIND((destroy(__new_start,__new_finish), 
-                  _M_deallocate(__new_start,__len)));
-    destroy(begin(), end());
-    _M_deallocate(_M_start, _M_end_of_storage - _M_start);
-    _M_start = __new_start;
-    _M_finish = __new_finish;
-    _M_end_of_storage = __new_start + __len;
+    __STL_UNWIND(_M_deallocate(__new_start,__len));
+    _M_relocate(__position, __new_start, __gap + 1, __len);
   }
+}
+
+template <class _Tp, class _Alloc>
+void
+vector<_Tp, _Alloc>::_M_relocate(iterator __position, iterator __new_start,
+                                 iterator __gap_end, size_type __len)
+{
+  typedef typename __relocate_traits<_Tp>::_Trivially_relocatable _Trivial;
+  iterator __new_finish = __gap_end + (_M_finish - __position);
+  _M_relocate_aux(__position, __new_start, __gap_end, __len, _Trivial());
+  _M_deallocate(_M_start, _M_end_of_storage - _M_start);
+  _M_start = __new_start;
+  _M_finish = __new_finish;
+  _M_end_of_storage = __new_start + __len;
+}
+
+template <class _Tp, class _Alloc>
+void //ɰλƵͱmemcpyɣԭʼ
+vector<_Tp, _Alloc>::_M_relocate_aux(iterator __position,
+                                     iterator __new_start,
+                                     iterator __gap_end, size_type,
+                                     __true_type)
+{
+  __uninitialized_relocate(_M_start, __position, __new_start);
+  __uninitialized_relocate(__position, _M_finish, __gap_end);
+}
+
+template <class _Tp, class _Alloc>
+void
+vector<_Tp, _Alloc>::_M_relocate_aux(iterator __position,
+                                     iterator __new_start,
+                                     iterator __gap_end, size_type __len,
+                                     __false_type)
+{
+  // Both halves are built before either is destroyed, so a throwing
+  // copy leaves the vector as it was.
+  iterator __gap = __new_start + (__position - _M_start);
+  iterator __new_finish = __new_start;
+  __STL_TRY {
+    __new_finish = __uninitialized_move(_M_start, __position, __new_start);
+    __uninitialized_move(__position, _M_finish, __gap_end);
+  }
+  __STL_UNWIND((destroy(__new_start, __new_finish),
+                destroy(__gap, __gap_end),
+                _M_deallocate(__new_start, __len)));
+  destroy(_M_start, _M_finish);
+}
+
+template <class _Tp, class _Alloc>
+bool
+vector<_Tp, _Alloc>::_M_expand_aux(size_type __len, __true_type)
+{
+  if (0 == _M_start)
+    return false;
+  const size_type __size = size();
+  iterator __p = _M_reallocate(_M_start, _M_end_of_storage - _M_start, __len);
+  if (0 == __p)
+    return false;
+  _M_start = __p;
+  _M_finish = __p + __size;
+  _M_end_of_storage = __p + __len;
+  return true;
 }
\ No newline at end of file
@@ -41,6 +41,8 @@ protected:
     { return _M_data_allocator.allocate(__n); }
   void _M_deallocate(_Tp* __p, size_t __n)//ͷſռ
     { if (__p) _M_data_allocator.deallocate(__p, __n); }
+  _Tp* _M_reallocate(_Tp* __p, size_t __old_n, size_t __new_n)
+    { return __reallocate_block(_M_data_allocator, __p, __old_n, __new_n); }
 };
 
 // Specialization for allocators that have the property that we don't
@@ -66,6 +68,8 @@ protected:
     { return _Alloc_type::allocate(__n); }
   void _M_deallocate(_Tp* __p, size_t __n)
     { _Alloc_type::deallocate(__p, __n);}
+  _Tp* _M_reallocate(_Tp* __p, size_t __old_n, size_t __new_n)
+    { return __reallocate_block((_Alloc_type*) 0, __p, __old_n, __new_n); }
 };
 
 template <class _Tp, class _Alloc>
@@ -120,10 +124,62 @@ protected:
     { return _M_data_allocator::allocate(__n); }
   void _M_deallocate(_Tp* __p, size_t __n) //ͷڴռ
     { _M_data_allocator::deallocate(__p, __n); }
+  //͵飬֧ʱ0
+  _Tp* _M_reallocate(_Tp* __p, size_t __old_n, size_t __new_n)
+    { return __reallocate_block((_M_data_allocator*) 0, __p, __old_n,
+                                __new_n); }
 };
 
 #endif /* __STL_USE_STD_ALLOCATORS */
 
+// Growth policies.  _S_grow(__old, __n, __size) returns the capacity a
+// vector of __old elements of __size bytes moves to when it needs room
+// for __n more.  The vector never takes less than __old + __n.
+
+// Grows by the factor __num/__den, or by __n if that is more.
+// __vector_growth_factor<2, 1> is the classic doubling.  A factor of
+// 3/2 wastes less memory and lets the allocator reuse freed blocks,
+// at the price of more reallocations.
+template <size_t __num, size_t __den>
+struct __vector_growth_factor {
+  static size_t _S_grow(size_t __old, size_t __n, size_t)
+  {
+    size_t __step = __old / __den * (__num - __den)
+                  + __old % __den * (__num - __den) / __den;
+    return __old + (__step > __n ? __step : __n);
+  }
+};
+
+// Grows as _Base until the elements fill __threshold bytes, then by
+// __step bytes at a time, so a huge vector does not double its
+// footprint each time it grows.  A step is never less than 1/64 of
+// __threshold, rounded up to whole elements, so a small __step or a
+// large element cannot bring growth down to one element per insert.
+template <size_t __threshold, size_t __step,
+          class _Base = __vector_growth_factor<2, 1> >
+struct __vector_growth_capped {
+  static size_t _S_grow(size_t __old, size_t __n, size_t __size)
+  {
+    if (__old * __size < __threshold)
+      return _Base::_S_grow(__old, __n, __size);
+    //ֵÿֻӹ̶ֵֽ1/64
+    size_t __bytes = __step > __threshold / 64 ? __step : __threshold / 64;
+    size_t __s = (__bytes + __size - 1) / __size;//һԪ
+    return __old + (__s > __n ? __s : __n);
+  }
+};
+
+#ifndef __STL_VECTOR_GROWTH
+# define __STL_VECTOR_GROWTH __vector_growth_factor<2, 1>
+#endif
+
+// The policy vector<_Tp, _Alloc> grows by.  Define __STL_VECTOR_GROWTH
+// to change it for every vector, or specialize this for one of them.
+template <class _Tp, class _Alloc>
+struct __vector_growth {
+  typedef __STL_VECTOR_GROWTH _Policy;
+};
+
 /*vectorĹ캯*******************************************
 /**********************************************************************
 ***	//ĬϹ캯*****************************************************
@@ -190,6 +246,7 @@ protected:
 #ifdef __STL_HAS_NAMESPACES
   using _Base::_M_allocate;
   using _Base::_M_deallocate;
+  using _Base::_M_reallocate;
   using _Base::_M_start;
   using _Base::_M_finish;
   using _Base::_M_end_of_storage;
@@ -199,6 +256,47 @@ protected://
   void _M_insert_aux(iterator __position, const _Tp& __x);
   void _M_insert_aux(iterator __position);
 
+  // Reallocation.  The caller allocates __len slots at __new_start and
+  // builds the new elements in the slots where they will end up, from
+  // __new_start + (__position - _M_start) up to __gap_end.  _M_relocate
+  // then relocates the old elements around them and frees the old
+  // storage.  Building the new elements first means the old ones are
+  // untouched if that throws, and trivially relocatable elements are
+  // then moved with memcpy instead of being copied and destroyed.
+  void _M_relocate(iterator __position, iterator __new_start,
+                   iterator __gap_end, size_type __len);
+  void _M_relocate_aux(iterator __position, iterator __new_start,
+                       iterator __gap_end, size_type __len, __true_type);
+  void _M_relocate_aux(iterator __position, iterator __new_start,
+                       iterator __gap_end, size_type __len, __false_type);
+
+  // The capacity to reallocate to when __n more elements do not fit.
+  size_type _M_next_capacity(size_type __n) const {
+    typedef typename __vector_growth<_Tp, _Alloc>::_Policy _Growth;
+    const size_type __old_size = size();
+    size_type __len = _Growth::_S_grow(__old_size, __n, sizeof(_Tp));
+    return __len < __old_size + __n ? __old_size + __n : __len;
+  }
+
+  // In-place expansion.  For trivially relocatable elements, asks the
+  // allocator to resize the block to __len (realloc, which may extend
+  // it where it lies or remap its pages), so the old and new buffers
+  // need not both be alive.  Returns false if that cannot be done.
+  bool _M_expand(size_type __len) {
+    typedef typename __relocate_traits<_Tp>::_Trivially_relocatable _Trivial;
+    return _M_expand_aux(__len, _Trivial());
+  }
+  bool _M_expand_aux(size_type __len, __true_type);
+  bool _M_expand_aux(size_type, __false_type) { return false; }
+
+  // After _M_expand has moved the elements away from __old_addr, a
+  // reference to one of them must follow; any other is returned as is.
+  const _Tp& _M_rebase(const _Tp& __x, size_t __old_addr) const {
+    size_t __off = (size_t) &__x - __old_addr;
+    return __off < size() * sizeof(_Tp)
+             ? *(const _Tp*) ((const char*) _M_start + __off) : __x;
+  }
+
 public://vector
   iterator begin() { return _M_start; }//ָڴռʼַĵ
   const_iterator begin() const { return _M_start; }
@@ -294,16 +392,10 @@ public://
 
   vector<_Tp, _Alloc>& operator=(const vector<_Tp, _Alloc>& __x);
   void reserve(size_type __n) {//ıÿռڴС
-    if (capacity() < __n) {
-      const size_type __old_size = size();
-	  //·СΪnڴռ䣬ԭݸƵ·ռ
-      iterator __tmp = _M_allocate_and_copy(__n, _M_start, _M_finish);
-      destroy(_M_start, _M_finish);//ͷԪض
-      _M_deallocate(_M_start, _M_end_of_storage - _M_start);//ԭڴռ
-	  //ָĵַ,ΪԭָĵַѾʧЧ
-      _M_start = __tmp;
-      _M_finish = __tmp + __old_size;
-      _M_end_of_storage = _M_start + __n;
+    if (capacity() < __n && !_M_expand(__n)) {
+	  //·СΪnڴռ䣬ԭݰƵ·ռ
+      iterator __tmp = _M_allocate(__n);
+      _M_relocate(_M_finish, __tmp, __tmp + size(), __n);
     }
   }
 
@@ -418,9 +510,50 @@ public://
                           __false_type) {
     _M_range_insert(__pos, __first, __last, __ITERATOR_CATEGORY(__first));
   }
+
+  // Bulk insertion.  insert_range grows the vector at most once and
+  // moves the elements after __pos at most once, whatever the iterator
+  // category: a single-pass range is first staged in a temporary
+  // vector.  Returns an iterator to the first inserted element.
+  template <class _InputIterator>
+  iterator insert_range(iterator __pos,
+                        _InputIterator __first, _InputIterator __last) {
+    size_type __n = __pos - begin();
+    _M_bulk_insert(__pos, __first, __last, __ITERATOR_CATEGORY(__first));
+    return begin() + __n;
+  }
+
+  template <class _InputIterator>
+  void append_range(_InputIterator __first, _InputIterator __last)
+    { _M_bulk_insert(end(), __first, __last, __ITERATOR_CATEGORY(__first)); }
+
+  template <class _InputIterator>
+  void _M_bulk_insert(iterator __pos,
+                      _InputIterator __first, _InputIterator __last,
+                      input_iterator_tag) {
+    vector<_Tp, _Alloc> __tmp(get_allocator());//ݴ
+    for ( ; __first != __last; ++__first)
+      __tmp.push_back(*__first);
+    _M_insert_staged(__pos, __tmp);
+  }
+
+  template <class _ForwardIterator>
+  void _M_bulk_insert(iterator __pos,
+                      _ForwardIterator __first, _ForwardIterator __last,
+                      forward_iterator_tag)
+    { _M_range_insert(__pos, __first, __last, forward_iterator_tag()); }
 #else /* __STL_MEMBER_TEMPLATES */
   void insert(iterator __position,
               const_iterator __first, const_iterator __last);
+
+  iterator insert_range(iterator __pos,
+                        const_iterator __first, const_iterator __last) {
+    size_type __n = __pos - begin();
+    insert(__pos, __first, __last);
+    return begin() + __n;
+  }
+  void append_range(const_iterator __first, const_iterator __last)
+    { insert(end(), __first, __last); }
 #endif /* __STL_MEMBER_TEMPLATES */
 
   void insert (iterator __pos, size_type __n, const _Tp& __x)
@@ -428,6 +561,19 @@ public://
 
   void _M_fill_insert (iterator __pos, size_type __n, const _Tp& __x);
 
+  // Inserts the elements of __tmp, a temporary holding a staged range,
+  // leaving __tmp empty.  Trivially relocatable elements are moved out
+  // of it with memcpy; others are copied.
+  void _M_insert_staged(iterator __pos, vector<_Tp, _Alloc>& __tmp) {
+    typedef typename __relocate_traits<_Tp>::_Trivially_relocatable _Trivial;
+    _M_insert_staged_aux(__pos, __tmp, _Trivial());
+  }
+  void _M_insert_staged_aux(iterator __pos, vector<_Tp, _Alloc>& __tmp,
+                            __true_type);
+  void _M_insert_staged_aux(iterator __pos, vector<_Tp, _Alloc>& __tmp,
+                            __false_type)
+    { insert(__pos, __tmp.begin(), __tmp.end()); }
+
   void pop_back() {//ȡβԪ
     --_M_finish;
     destroy(_M_finish);//
@@ -441,21 +587,35 @@ public://
   }
   iterator erase(iterator __first, iterator __last) {//Ԫ
     iterator __i = copy(__last, _M_finish, __first);//ѲԪǰ
-    destroy(__i, _M_finish);//
-    _M_finish = _M_finish - (__last - __first);//finishָλ
+    _Destroy_n(__i, __last - __first);//β
+    _M_finish = __i;//finishָλ
     return __first;
   }
 
   void resize(size_type __new_size, const _Tp& __x) {//ıпɴ洢ԪظµĿռ
     if (__new_size < size()) //ڴռԭС
-      erase(begin() + __new_size, end());//Ԫ
+      _M_erase_at_end(_M_start + __new_size);//Ԫ
     else
       insert(end(), __new_size - size(), __x);//ԭĿռ䶼ֵx
   }
-  void resize(size_type __new_size) { resize(__new_size, _Tp()); }
-  void clear() { erase(begin(), end()); }//
+  // Default-constructs the new elements in place when they fit,
+  // instead of copying a temporary into each.
+  void resize(size_type __new_size) {
+    if (__new_size < size())
+      _M_erase_at_end(_M_start + __new_size);
+    else if (__new_size <= capacity())
+      _M_finish = _Construct_n(_M_finish, __new_size - size());
+    else
+      resize(__new_size, _Tp());
+  }
+  void clear() { _M_erase_at_end(_M_start); }//
 
 protected:
+  // Destroys [__pos, end()), nothing to move.
+  void _M_erase_at_end(iterator __pos) {
+    _Destroy_n(__pos, _M_finish - __pos);
+    _M_finish = __pos;
+  }
 
 #ifdef __STL_MEMBER_TEMPLATES
   template <class _ForwardIterator>//ڴ棬Ҹ
@@ -517,6 +677,15 @@ protected:
 #endif /* __STL_MEMBER_TEMPLATES */
 };
 
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
+// A vector is three pointers into the heap, so a vector of vectors
+// relocates its elements with memcpy when it grows.
+template <class _Tp, class _Alloc>
+struct __relocate_traits<vector<_Tp, _Alloc> > {
+  typedef __true_type _Trivially_relocatable;
+};
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
 template <class _Tp, class _Alloc>
 inline bool //أжǷȣСǷ
 operator==(const vector<_Tp, _Alloc>& __x, const vector<_Tp, _Alloc>& __y)
@@ -608,7 +777,7 @@ vector<_Tp,_Alloc>::operator=(const vector<_Tp, _Alloc>& __x)
     }
     else if (size() >= __xlen) {
       iterator __i = copy(__x.begin(), __x.end(), begin());
-      destroy(__i, _M_finish);
+      _Destroy_n(__i, _M_finish - __i);
     }
     else {
       copy(__x.begin(), __x.begin() + size(), _M_start);
@@ -631,7 +800,7 @@ void vector<_Tp, _Alloc>::_M_fill_assign(size_t __n, const value_type& __val)
     _M_finish = uninitialized_fill_n(_M_finish, __n - size(), __val);
   }
   else
-    erase(fill_n(begin(), __n, __val), end());
+    _M_erase_at_end(fill_n(begin(), __n, __val));
 }
 
 #ifdef __STL_MEMBER_TEMPLATES
@@ -643,7 +812,7 @@ void vector<_Tp, _Alloc>::_M_assign_aux(_InputIter __first, _InputIter __last,
   for ( ; __first != __last && __cur != end(); ++__cur, ++__first)
     *__cur = *__first;
   if (__first == __last)
-    erase(__cur, end());
+    _M_erase_at_end(__cur);
   else
     insert(end(), __first, __last);
 }
@@ -663,9 +832,7 @@ vector<_Tp, _Alloc>::_M_assign_aux(_ForwardIter __first, _ForwardIter __last,
     _M_end_of_storage = _M_finish = _M_start + __len;
   }
   else if (size() >= __len) {
-    iterator __new_finish = copy(__first, __last, _M_start);
-    destroy(__new_finish, _M_finish);
-    _M_finish = __new_finish;
+    _M_erase_at_end(copy(__first, __last, _M_start));
   }
   else {
     _ForwardIter __mid = __first;
@@ -701,29 +868,24 @@ vector<_Tp, _Alloc>::_M_insert_aux(iterator __position, const _Tp& __x)
     *__position = __x_copy;//x뵽ָλ
   }
   else {//ڿõڴռ,·ռ䣬ʹҪ
-    const size_type __old_size = size();//ԭڴռС
-	/*ԭʼռ䲻0·ĿռΪԭ
+	/*¿ռСԾĬΪԭ
 	*ԭʼռΪ0·ĿռΪ1
 	*/
-    const size_type __len = __old_size != 0 ? 2 * __old_size : 1;
+    const size_type __len = _M_next_capacity(1);
+    const size_type __elems_before = __position - _M_start;
+    const size_t __old_addr = (size_t) _M_start;
+    if (_M_expand(__len)) {//ԭѾ͵չתΪпÿռ
+      insert(_M_start + __elems_before, _M_rebase(__x, __old_addr));
+      return;
+    }
     iterator __new_start = _M_allocate(__len);//СΪlenڴռ
-    iterator __new_finish = __new_start;
+    iterator __gap = __new_start + __elems_before;
     __STL_TRY {
-		//[start,position)ԭʼݸƵµڴռ
-      __new_finish = uninitialized_copy(_M_start, __position, __new_start);
-      construct(__new_finish, __x);//xֵ뵽ָλ
-      ++__new_finish;
-	  //[position,finish)ԭʼʣݵµĿռ
-      __new_finish = uninitialized_copy(__position, _M_finish, __new_finish);
+      construct(__gap, __x);//Ȱx¿ռеλ
     }
-    __STL_UNWIND((destroy(__new_start,__new_finish), 
-                  _M_deallocate(__new_start,__len)));
-    destroy(begin(), end());//ԭʼ
-    _M_deallocate(_M_start, _M_end_of_storage - _M_start);//ͷԭڴռ
-	//ָĵַ
-    _M_start = __new_start;
-    _M_finish = __new_finish;
-    _M_end_of_storage = __new_start + __len;
+    __STL_UNWIND(_M_deallocate(__new_start,__len));
+	//ٰ[start,position)[position,finish)ԭʼݰƵx
+    _M_relocate(__position, __new_start, __gap + 1, __len);
   }
 }
 
@@ -738,26 +900,115 @@ vector<_Tp, _Alloc>::_M_insert_aux(iterator __position)
     *__position = _Tp();
   }
   else {
-    const size_type __old_size = size();
-    const size_type __len = __old_size != 0 ? 2 * __old_size : 1;
+    const size_type __len = _M_next_capacity(1);
+    const size_type __elems_before = __position - _M_start;
+    if (_M_expand(__len)) {
+      insert(_M_start + __elems_before);
+      return;
+    }
     iterator __new_start = _M_allocate(__len);
-    iterator __new_finish = __new_start;
+    iterator __gap = __new_start + __elems_before;
     __STL_TRY {
-      __new_finish = uninitialized_copy(_M_start, __position, __new_start);
-      construct(__new_finish);
-      ++__new_finish;
-      __new_finish = uninitialized_copy(__position, _M_finish, __new_finish);
+      construct(__gap);
     }
-    __STL_UNWIND((destroy(__new_start,__new_finish), 
-                  _M_deallocate(__new_start,__len)));
-    destroy(begin(), end());
-    _M_deallocate(_M_start, _M_end_of_storage - _M_start);
-    _M_start = __new_start;
-    _M_finish = __new_finish;
-    _M_end_of_storage = __new_start + __len;
+    __STL_UNWIND(_M_deallocate(__new_start,__len));
+    _M_relocate(__position, __new_start, __gap + 1, __len);
   }
 }
 
+template <class _Tp, class _Alloc>
+void
+vector<_Tp, _Alloc>::_M_relocate(iterator __position, iterator __new_start,
+                                 iterator __gap_end, size_type __len)
+{
+  typedef typename __relocate_traits<_Tp>::_Trivially_relocatable _Trivial;
+  iterator __new_finish = __gap_end + (_M_finish - __position);
+  _M_relocate_aux(__position, __new_start, __gap_end, __len, _Trivial());
+  _M_deallocate(_M_start, _M_end_of_storage - _M_start);
+  _M_start = __new_start;
+  _M_finish = __new_finish;
+  _M_end_of_storage = __new_start + __len;
+}
+
+template <class _Tp, class _Alloc>
+void //ɰλƵͱmemcpyɣԭʼ
+vector<_Tp, _Alloc>::_M_relocate_aux(iterator __position,
+                                     iterator __new_start,
+                                     iterator __gap_end, size_type,
+                                     __true_type)
+{
+  __uninitialized_relocate(_M_start, __position, __new_start);
+  __uninitialized_relocate(__position, _M_finish, __gap_end);
+}
+
+template <class _Tp, class _Alloc>
+void
+vector<_Tp, _Alloc>::_M_relocate_aux(iterator __position,
+                                     iterator __new_start,
+                                     iterator __gap_end, size_type __len,
+                                     __false_type)
+{
+  // Both halves are built before either is destroyed, so a throwing
+  // copy leaves the vector as it was.
+  iterator __gap = __new_start + (__position - _M_start);
+  iterator __new_finish = __new_start;
+  __STL_TRY {
+    __new_finish = __uninitialized_move(_M_start, __position, __new_start);
+    __uninitialized_move(__position, _M_finish, __gap_end);
+  }
+  __STL_UNWIND((destroy(__new_start, __new_finish),
+                destroy(__gap, __gap_end),
+                _M_deallocate(__new_start, __len)));
+  destroy(_M_start, _M_finish);
+}
+
+template <class _Tp, class _Alloc>
+bool
+vector<_Tp, _Alloc>::_M_expand_aux(size_type __len, __true_type)
+{
+  if (0 == _M_start)
+    return false;
+  const size_type __size = size();
+  iterator __p = _M_reallocate(_M_start, _M_end_of_storage - _M_start, __len);
+  if (0 == __p)
+    return false;
+  _M_start = __p;
+  _M_finish = __p + __size;
+  _M_end_of_storage = __p + __len;
+  return true;
+}
+
+template <class _Tp, class _Alloc>
+void
+vector<_Tp, _Alloc>::_M_insert_staged_aux(iterator __position,
+                                          vector<_Tp, _Alloc>& __tmp,
+                                          __true_type)
+{
+  const size_type __n = __tmp.size();
+  if (__n == 0)
+    return;
+  const size_type __elems_before = __position - _M_start;
+  if (size_type(_M_end_of_storage - _M_finish) < __n) {
+    const size_type __len = _M_next_capacity(__n);
+    if (!_M_expand(__len)) {
+      iterator __new_start = _M_allocate(__len);
+      memcpy((void*) (__new_start + __elems_before), (const void*) __tmp._M_start,
+             __n * sizeof(_Tp));
+      __tmp._M_finish = __tmp._M_start;//ԪѰߣtmp
+      _M_relocate(__position, __new_start, __new_start + __elems_before + __n,
+                  __len);
+      return;
+    }
+    __position = _M_start + __elems_before;
+  }
+  //βԪһΣճλֱӷtmpеԪ
+  memmove((void*) (__position + __n), (const void*) __position,
+          (_M_finish - __position) * sizeof(_Tp));
+  memcpy((void*) __position, (const void*) __tmp._M_start, __n * sizeof(_Tp));
+  __tmp._M_finish = __tmp._M_start;
+  _M_finish += __n;
+}
+
 template <class _Tp, class _Alloc>
 void vector<_Tp, _Alloc>::_M_fill_insert(iterator __position, size_type __n, 
                                          const _Tp& __x)
@@ -782,23 +1033,21 @@ void vector<_Tp, _Alloc>::_M_fill_insert(iterator __position, size_type __n,
       }
     }
     else {
-      const size_type __old_size = size();        
-      const size_type __len = __old_size + max(__old_size, __n);
+      const size_type __len = _M_next_capacity(__n);
+      const size_type __elems_before = __position - _M_start;
+      const size_t __old_addr = (size_t) _M_start;
+      if (_M_expand(__len)) {
+        _M_fill_insert(_M_start + __elems_before, __n,
+                       _M_rebase(__x, __old_addr));
+        return;
+      }
       iterator __new_start = _M_allocate(__len);
-      iterator __new_finish = __new_start;
+      iterator __gap_end = __new_start;
       __STL_TRY {
-        __new_finish = uninitialized_copy(_M_start, __position, __new_start);
-        __new_finish = uninitialized_fill_n(__new_finish, __n, __x);
-        __new_finish
-          = uninitialized_copy(__position, _M_finish, __new_finish);
+        __gap_end = uninitialized_fill_n(__new_start + __elems_before, __n, __x);
       }
-      __STL_UNWIND((destroy(__new_start,__new_finish), 
-                    _M_deallocate(__new_start,__len)));
-      destroy(_M_start, _M_finish);
-      _M_deallocate(_M_start, _M_end_of_storage - _M_start);
-      _M_start = __new_start;
-      _M_finish = __new_finish;
-      _M_end_of_storage = __new_start + __len;
+      __STL_UNWIND(_M_deallocate(__new_start,__len));
+      _M_relocate(__position, __new_start, __gap_end, __len);
     }
   }
 }
@@ -812,10 +1061,17 @@ vector<_Tp, _Alloc>::_M_range_insert(iterator __pos,
                                      _InputIterator __last,
                                      input_iterator_tag)
 {
-  for ( ; __first != __last; ++__first) {
-    __pos = insert(__pos, *__first);
-    ++__pos;
+  if (__pos == end()) {//β˲룬ƶκԪ
+    for ( ; __first != __last; ++__first)
+      push_back(*__first);
+    return;
   }
+  // Inserting one by one would move the tail once per element.  Stage
+  // the range instead, then open the gap once.
+  vector<_Tp, _Alloc> __tmp(get_allocator());
+  for ( ; __first != __last; ++__first)
+    __tmp.push_back(*__first);
+  _M_insert_staged(__pos, __tmp);
 }
 
 template <class _Tp, class _Alloc> template <class _ForwardIterator>
@@ -848,23 +1104,21 @@ vector<_Tp, _Alloc>::_M_range_insert(iterator __position,
       }
     }
     else {
-      const size_type __old_size = size();
-      const size_type __len = __old_size + max(__old_size, __n);
+      const size_type __len = _M_next_capacity(__n);
+      const size_type __elems_before = __position - _M_start;
+      if (_M_expand(__len)) {
+        _M_range_insert(_M_start + __elems_before, __first, __last,
+                        forward_iterator_tag());
+        return;
+      }
       iterator __new_start = _M_allocate(__len);
-      iterator __new_finish = __new_start;
+      iterator __gap_end = __new_start;
       __STL_TRY {
-        __new_finish = uninitialized_copy(_M_start, __position, __new_start);
-        __new_finish = uninitialized_copy(__first, __last, __new_finish);
-        __new_finish
-          = uninitialized_copy(__position, _M_finish, __new_finish);
+        __gap_end = uninitialized_copy(__first, __last,
+                                       __new_start + __elems_before);
       }
-      __STL_UNWIND((destroy(__new_start,__new_finish), 
-                    _M_deallocate(__new_start,__len)));
-      destroy(_M_start, _M_finish);
-      _M_deallocate(_M_start, _M_end_of_storage - _M_start);
-      _M_start = __new_start;
-      _M_finish = __new_finish;
-      _M_end_of_storage = __new_start + __len;
+      __STL_UNWIND(_M_deallocate(__new_start,__len));
+      _M_relocate(__position, __new_start, __gap_end, __len);
     }
   }
 }
@@ -898,29 +1152,664 @@ vector<_Tp, _Alloc>::insert(iterator __position,
       }
     }
     else {
-      const size_type __old_size = size();
-      const size_type __len = __old_size + max(__old_size, __n);
+      const size_type __len = _M_next_capacity(__n);
+      const size_type __elems_before = __position - _M_start;
+      if (_M_expand(__len)) {
+        insert(_M_start + __elems_before, __first, __last);
+        return;
+      }
       iterator __new_start = _M_allocate(__len);
-      iterator __new_finish = __new_start;
+      iterator __gap_end = __new_start;
       __STL_TRY {
-        __new_finish = uninitialized_copy(_M_start, __position, __new_start);
-        __new_finish = uninitialized_copy(__first, __last, __new_finish);
-        __new_finish
-          = uninitialized_copy(__position, _M_finish, __new_finish);
+        __gap_end = uninitialized_copy(__first, __last,
+                                       __new_start + __elems_before);
       }
-      __STL_UNWIND((destroy(__new_start,__new_finish),
-                    _M_deallocate(__new_start,__len)));
-      destroy(_M_start, _M_finish);
-      _M_deallocate(_M_start, _M_end_of_storage - _M_start);
-      _M_start = __new_start;
-      _M_finish = __new_finish;
-      _M_end_of_storage = __new_start + __len;
+      __STL_UNWIND(_M_deallocate(__new_start,__len));
+      _M_relocate(__position, __new_start, __gap_end, __len);
     }
   }
 }
 
 #endif /* __STL_MEMBER_TEMPLATES */
 
+// small_vector<_Tp, __N, _Alloc> is a vector whose first __N elements
+// live inside the object itself.  Most vectors stay small, and those
+// never touch the allocator.  Past __N elements the contents move to a
+// heap block obtained through _Vector_base, exactly as vector's, and
+// grow by the same policy.
+//
+// Because its elements may live inside it, a small_vector is not
+// trivially relocatable, and swap and the copy operations cost O(size)
+// while either side is inline.
+
+// The base keeps the inline buffer and makes sure _Vector_base never
+// sees it: whenever the elements are inline at destruction, the
+// pointers are cleared first, so there is nothing for _Vector_base to
+// free.
+template <class _Tp, size_t __N, class _Alloc>
+class _Small_vector_base : public _Vector_base<_Tp, _Alloc> {
+public:
+  typedef _Vector_base<_Tp, _Alloc> _Base;
+  typedef typename _Base::allocator_type allocator_type;
+
+  _Small_vector_base(const allocator_type& __a) : _Base(__a) {
+    _M_start = _M_finish = _M_inline();
+    _M_end_of_storage = _M_start + __N;
+  }
+  ~_Small_vector_base() {
+    if (_M_is_inline())
+      _M_start = _M_finish = _M_end_of_storage = 0;
+  }
+
+protected:
+#ifdef __STL_HAS_NAMESPACES
+  using _Base::_M_start;
+  using _Base::_M_finish;
+  using _Base::_M_end_of_storage;
+#endif /* __STL_HAS_NAMESPACES */
+
+  // An empty inline buffer would be a zero-length array; use vector.
+  typedef char _N_must_be_positive[__N > 0 ? 1 : -1];
+
+  union _Storage {//û屣֤
+    char _M_bytes[__N * sizeof(_Tp)];
+    long double _M_align_long_double;
+    double _M_align_double;
+    long _M_align_long;
+    void* _M_align_pointer;
+    void (*_M_align_function)();
+  };
+  _Storage _M_storage;
+
+  // The union aligns for every fundamental type.  A _Tp that asks for
+  // more cannot live in it and is rejected here.  Each probe's size
+  // minus its member's is that member's alignment.
+  struct _Tp_align_probe { char _M_c; _Tp _M_t; };
+  struct _Storage_align_probe { char _M_c; _Storage _M_s; };
+  typedef char _Tp_over_aligned[
+    sizeof(_Tp_align_probe) - sizeof(_Tp)
+      <= sizeof(_Storage_align_probe) - sizeof(_Storage) ? 1 : -1];
+
+  _Tp* _M_inline() { return (_Tp*) _M_storage._M_bytes; }
+  const _Tp* _M_inline() const { return (const _Tp*) _M_storage._M_bytes; }
+  bool _M_is_inline() const { return _M_start == _M_inline(); }
+};
+
+template <class _Tp, size_t __N, class _Alloc = __STL_DEFAULT_ALLOCATOR(_Tp) >
+class small_vector : protected _Small_vector_base<_Tp, __N, _Alloc>
+{
+  // requirements:
+
+  __STL_CLASS_REQUIRES(_Tp, _Assignable);
+
+private:
+  typedef _Small_vector_base<_Tp, __N, _Alloc> _Base;
+public:
+  typedef _Tp value_type;
+  typedef value_type* pointer;
+  typedef const value_type* const_pointer;
+  typedef value_type* iterator;
+  typedef const value_type* const_iterator;
+  typedef value_type& reference;
+  typedef const value_type& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+  typedef typename _Base::allocator_type allocator_type;
+  allocator_type get_allocator() const { return _Base::get_allocator(); }
+
+#ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
+  typedef reverse_iterator<const_iterator> const_reverse_iterator;
+  typedef reverse_iterator<iterator> reverse_iterator;
+#else /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+  typedef reverse_iterator<const_iterator, value_type, const_reference, 
+                           difference_type>  const_reverse_iterator;
+  typedef reverse_iterator<iterator, value_type, reference, difference_type>
+          reverse_iterator;
+#endif /* __STL_CLASS_PARTIAL_SPECIALIZATION */
+
+protected:
+#ifdef __STL_HAS_NAMESPACES
+  using _Base::_M_allocate;
+  using _Base::_M_deallocate;
+  using _Base::_M_start;
+  using _Base::_M_finish;
+  using _Base::_M_end_of_storage;
+  using _Base::_M_inline;
+  using _Base::_M_is_inline;
+#endif /* __STL_HAS_NAMESPACES */
+
+protected:
+  size_type _M_next_capacity(size_type __n) const {
+    typedef typename __vector_growth<_Tp, _Alloc>::_Policy _Growth;
+    const size_type __old_size = size();
+    size_type __len = _Growth::_S_grow(__old_size, __n, sizeof(_Tp));
+    return __len < __old_size + __n ? __old_size + __n : __len;
+  }
+
+  // Relocates the elements to a heap block of __len elements.
+  void _M_grow(size_type __len);
+
+  // After _M_grow, a reference to one of the old elements must follow
+  // it to the new block.
+  const _Tp& _M_rebase(const _Tp& __x, size_t __old_addr) const {
+    size_t __off = (size_t) &__x - __old_addr;
+    return __off < size() * sizeof(_Tp)
+             ? *(const _Tp*) ((const char*) _M_start + __off) : __x;
+  }
+
+  void _M_insert_aux(iterator __position, const _Tp& __x);
+  void _M_fill_insert(iterator __pos, size_type __n, const _Tp& __x);
+  void _M_swap_inline(small_vector<_Tp, __N, _Alloc>& __x);
+
+public:
+  iterator begin() { return _M_start; }
+  const_iterator begin() const { return _M_start; }
+  iterator end() { return _M_finish; }
+  const_iterator end() const { return _M_finish; }
+
+  reverse_iterator rbegin()
+    { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const
+    { return const_reverse_iterator(end()); }
+  reverse_iterator rend()
+    { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const
+    { return const_reverse_iterator(begin()); }
+
+  size_type size() const
+    { return size_type(end() - begin()); }
+  size_type max_size() const
+    { return size_type(-1) / sizeof(_Tp); }
+  size_type capacity() const
+    { return size_type(_M_end_of_storage - begin()); }
+  bool empty() const
+    { return begin() == end(); }
+
+  reference operator[](size_type __n) { return *(begin() + __n); }
+  const_reference operator[](size_type __n) const { return *(begin() + __n); }
+
+#ifdef __STL_THROW_RANGE_ERRORS
+  void _M_range_check(size_type __n) const {
+    if (__n >= this->size())
+      __stl_throw_range_error("small_vector");
+  }
+
+  reference at(size_type __n)
+    { _M_range_check(__n); return (*this)[__n]; }
+  const_reference at(size_type __n) const
+    { _M_range_check(__n); return (*this)[__n]; }
+#endif /* __STL_THROW_RANGE_ERRORS */
+
+  explicit small_vector(const allocator_type& __a = allocator_type())
+    : _Base(__a) {}
+
+  small_vector(size_type __n, const _Tp& __value,
+               const allocator_type& __a = allocator_type())
+    : _Base(__a)
+    { _M_fill_insert(_M_start, __n, __value); }
+
+  explicit small_vector(size_type __n)
+    : _Base(allocator_type())
+    { _M_fill_insert(_M_start, __n, _Tp()); }
+
+  small_vector(const small_vector<_Tp, __N, _Alloc>& __x)
+    : _Base(__x.get_allocator())
+    { insert(end(), __x.begin(), __x.end()); }
+
+#ifdef __STL_MEMBER_TEMPLATES
+  template <class _InputIterator>
+  small_vector(_InputIterator __first, _InputIterator __last,
+               const allocator_type& __a = allocator_type()) : _Base(__a) {
+    typedef typename _Is_integer<_InputIterator>::_Integral _Integral;
+    _M_insert_dispatch(end(), __first, __last, _Integral());
+  }
+#else
+  small_vector(const _Tp* __first, const _Tp* __last,
+               const allocator_type& __a = allocator_type())
+    : _Base(__a)
+    { insert(end(), __first, __last); }
+#endif /* __STL_MEMBER_TEMPLATES */
+
+  ~small_vector() { destroy(_M_start, _M_finish); }
+
+  small_vector<_Tp, __N, _Alloc>&
+  operator=(const small_vector<_Tp, __N, _Alloc>& __x);
+
+  void reserve(size_type __n) {
+    if (capacity() < __n)
+      _M_grow(__n);
+  }
+
+  void assign(size_type __n, const _Tp& __val) {
+    _Tp __val_copy = __val;//valڵԪ
+    clear();
+    _M_fill_insert(_M_start, __n, __val_copy);
+  }
+
+#ifdef __STL_MEMBER_TEMPLATES
+  template <class _InputIterator>
+  void assign(_InputIterator __first, _InputIterator __last) {
+    typedef typename _Is_integer<_InputIterator>::_Integral _Integral;
+    clear();
+    _M_insert_dispatch(end(), __first, __last, _Integral());
+  }
+#endif /* __STL_MEMBER_TEMPLATES */
+
+  reference front() { return *begin(); }
+  const_reference front() const { return *begin(); }
+  reference back() { return *(end() - 1); }
+  const_reference back() const { return *(end() - 1); }
+
+  void push_back(const _Tp& __x) {
+    if (_M_finish != _M_end_of_storage) {
+      construct(_M_finish, __x);
+      ++_M_finish;
+    }
+    else
+      _M_insert_aux(end(), __x);
+  }
+  void push_back() { push_back(_Tp()); }
+
+  // Heap blocks are exchanged as in vector::swap; inline elements have
+  // to be moved.
+  void swap(small_vector<_Tp, __N, _Alloc>& __x) {
+    if (!_M_is_inline() && !__x._M_is_inline()) {
+      __STD::swap(_M_start, __x._M_start);
+      __STD::swap(_M_finish, __x._M_finish);
+      __STD::swap(_M_end_of_storage, __x._M_end_of_storage);
+    }
+    else
+      _M_swap_inline(__x);
+  }
+
+  iterator insert(iterator __position, const _Tp& __x) {
+    size_type __n = __position - begin();
+    if (_M_finish != _M_end_of_storage && __position == end()) {
+      construct(_M_finish, __x);
+      ++_M_finish;
+    }
+    else
+      _M_insert_aux(__position, __x);
+    return begin() + __n;
+  }
+  iterator insert(iterator __position) { return insert(__position, _Tp()); }
+
+#ifdef __STL_MEMBER_TEMPLATES
+  template <class _InputIterator>
+  void insert(iterator __pos, _InputIterator __first, _InputIterator __last) {
+    typedef typename _Is_integer<_InputIterator>::_Integral _Integral;
+    _M_insert_dispatch(__pos, __first, __last, _Integral());
+  }
+
+  template <class _Integer>
+  void _M_insert_dispatch(iterator __pos, _Integer __n, _Integer __val,
+                          __true_type)
+    { _M_fill_insert(__pos, (size_type) __n, (_Tp) __val); }
+
+  template <class _InputIterator>
+  void _M_insert_dispatch(iterator __pos,
+                          _InputIterator __first, _InputIterator __last,
+                          __false_type) {
+    _M_range_insert(__pos, __first, __last, __ITERATOR_CATEGORY(__first));
+  }
+
+  // As in vector: one growth and one move of the tail at most.
+  template <class _InputIterator>
+  iterator insert_range(iterator __pos,
+                        _InputIterator __first, _InputIterator __last) {
+    size_type __n = __pos - begin();
+    _M_bulk_insert(__pos, __first, __last, __ITERATOR_CATEGORY(__first));
+    return begin() + __n;
+  }
+
+  template <class _InputIterator>
+  void append_range(_InputIterator __first, _InputIterator __last)
+    { _M_bulk_insert(end(), __first, __last, __ITERATOR_CATEGORY(__first)); }
+
+  template <class _InputIterator>
+  void _M_bulk_insert(iterator __pos,
+                      _InputIterator __first, _InputIterator __last,
+                      input_iterator_tag) {
+    vector<_Tp, _Alloc> __tmp(get_allocator());
+    for ( ; __first != __last; ++__first)
+      __tmp.push_back(*__first);
+    _M_range_insert(__pos, __tmp.begin(), __tmp.end(),
+                    forward_iterator_tag());
+  }
+
+  template <class _ForwardIterator>
+  void _M_bulk_insert(iterator __pos,
+                      _ForwardIterator __first, _ForwardIterator __last,
+                      forward_iterator_tag)
+    { _M_range_insert(__pos, __first, __last, forward_iterator_tag()); }
+
+  template <class _InputIterator>
+  void _M_range_insert(iterator __pos,
+                       _InputIterator __first, _InputIterator __last,
+                       input_iterator_tag) {
+    if (__pos == end()) {
+      for ( ; __first != __last; ++__first)
+        push_back(*__first);
+    }
+    else
+      _M_bulk_insert(__pos, __first, __last, input_iterator_tag());
+  }
+
+  template <class _ForwardIterator>
+  void _M_range_insert(iterator __pos,
+                       _ForwardIterator __first, _ForwardIterator __last,
+                       forward_iterator_tag);
+#else /* __STL_MEMBER_TEMPLATES */
+  void insert(iterator __position,
+              const_iterator __first, const_iterator __last);
+
+  iterator insert_range(iterator __pos,
+                        const_iterator __first, const_iterator __last) {
+    size_type __n = __pos - begin();
+    insert(__pos, __first, __last);
+    return begin() + __n;
+  }
+  void append_range(const_iterator __first, const_iterator __last)
+    { insert(end(), __first, __last); }
+#endif /* __STL_MEMBER_TEMPLATES */
+
+  void insert (iterator __pos, size_type __n, const _Tp& __x)
+    { _M_fill_insert(__pos, __n, __x); }
+
+  void pop_back() {
+    --_M_finish;
+    destroy(_M_finish);
+  }
+  iterator erase(iterator __position) {
+    if (__position + 1 != end())
+      copy(__position + 1, _M_finish, __position);
+    --_M_finish;
+    destroy(_M_finish);
+    return __position;
+  }
+  iterator erase(iterator __first, iterator __last) {
+    iterator __i = copy(__last, _M_finish, __first);
+    _Destroy_n(__i, __last - __first);
+    _M_finish = __i;
+    return __first;
+  }
+
+  void resize(size_type __new_size, const _Tp& __x) {
+    if (__new_size < size()) 
+      erase(begin() + __new_size, end());
+    else
+      insert(end(), __new_size - size(), __x);
+  }
+  void resize(size_type __new_size) { resize(__new_size, _Tp()); }
+  void clear() { erase(begin(), end()); }
+};
+
+template <class _Tp, size_t __N, class _Alloc>
+void small_vector<_Tp, __N, _Alloc>::_M_grow(size_type __len)
+{
+  const size_type __size = size();
+  iterator __new_start = _M_allocate(__len);
+  __STL_TRY {
+    __uninitialized_relocate(_M_start, _M_finish, __new_start);
+  }
+  __STL_UNWIND(_M_deallocate(__new_start, __len));
+  if (!_M_is_inline())//û
+    _M_deallocate(_M_start, _M_end_of_storage - _M_start);
+  _M_start = __new_start;
+  _M_finish = __new_start + __size;
+  _M_end_of_storage = __new_start + __len;
+}
+
+template <class _Tp, size_t __N, class _Alloc>
+void 
+small_vector<_Tp, __N, _Alloc>::_M_insert_aux(iterator __position,
+                                              const _Tp& __x)
+{
+  if (_M_finish == _M_end_of_storage) {//ݣٰпÿռβ
+    const size_type __elems_before = __position - _M_start;
+    const size_t __old_addr = (size_t) _M_start;
+    _M_grow(_M_next_capacity(1));
+    insert(_M_start + __elems_before, _M_rebase(__x, __old_addr));
+    return;
+  }
+  construct(_M_finish, *(_M_finish - 1));
+  ++_M_finish;
+  _Tp __x_copy = __x;
+  copy_backward(__position, _M_finish - 2, _M_finish - 1);
+  *__position = __x_copy;
+}
+
+template <class _Tp, size_t __N, class _Alloc>
+void small_vector<_Tp, __N, _Alloc>::_M_fill_insert(iterator __position,
+                                                    size_type __n, 
+                                                    const _Tp& __x)
+{
+  if (__n == 0)
+    return;
+  if (size_type(_M_end_of_storage - _M_finish) < __n) {
+    const size_type __elems_before = __position - _M_start;
+    const size_t __old_addr = (size_t) _M_start;
+    _M_grow(_M_next_capacity(__n));
+    _M_fill_insert(_M_start + __elems_before, __n,
+                   _M_rebase(__x, __old_addr));
+    return;
+  }
+  _Tp __x_copy = __x;
+  const size_type __elems_after = _M_finish - __position;
+  iterator __old_finish = _M_finish;
+  if (__elems_after > __n) {
+    uninitialized_copy(_M_finish - __n, _M_finish, _M_finish);
+    _M_finish += __n;
+    copy_backward(__position, __old_finish - __n, __old_finish);
+    fill(__position, __position + __n, __x_copy);
+  }
+  else {
+    uninitialized_fill_n(_M_finish, __n - __elems_after, __x_copy);
+    _M_finish += __n - __elems_after;
+    uninitialized_copy(__position, __old_finish, _M_finish);
+    _M_finish += __elems_after;
+    fill(__position, __old_finish, __x_copy);
+  }
+}
+
+#ifdef __STL_MEMBER_TEMPLATES
+
+template <class _Tp, size_t __N, class _Alloc> template <class _ForwardIterator>
+void 
+small_vector<_Tp, __N, _Alloc>::_M_range_insert(iterator __position,
+                                                _ForwardIterator __first,
+                                                _ForwardIterator __last,
+                                                forward_iterator_tag)
+{
+  size_type __n = 0;
+  distance(__first, __last, __n);
+  if (__n == 0)
+    return;
+  if (size_type(_M_end_of_storage - _M_finish) < __n) {
+    const size_type __elems_before = __position - _M_start;
+    _M_grow(_M_next_capacity(__n));
+    __position = _M_start + __elems_before;
+  }
+  const size_type __elems_after = _M_finish - __position;
+  iterator __old_finish = _M_finish;
+  if (__elems_after > __n) {
+    uninitialized_copy(_M_finish - __n, _M_finish, _M_finish);
+    _M_finish += __n;
+    copy_backward(__position, __old_finish - __n, __old_finish);
+    copy(__first, __last, __position);
+  }
+  else {
+    _ForwardIterator __mid = __first;
+    advance(__mid, __elems_after);
+    uninitialized_copy(__mid, __last, _M_finish);
+    _M_finish += __n - __elems_after;
+    uninitialized_copy(__position, __old_finish, _M_finish);
+    _M_finish += __elems_after;
+    copy(__first, __mid, __position);
+  }
+}
+
+#else /* __STL_MEMBER_TEMPLATES */
+
+template <class _Tp, size_t __N, class _Alloc>
+void 
+small_vector<_Tp, __N, _Alloc>::insert(iterator __position, 
+                                       const_iterator __first, 
+                                       const_iterator __last)
+{
+  size_type __n = __last - __first;
+  if (__n == 0)
+    return;
+  if (size_type(_M_end_of_storage - _M_finish) < __n) {
+    const size_type __elems_before = __position - _M_start;
+    _M_grow(_M_next_capacity(__n));
+    __position = _M_start + __elems_before;
+  }
+  const size_type __elems_after = _M_finish - __position;
+  iterator __old_finish = _M_finish;
+  if (__elems_after > __n) {
+    uninitialized_copy(_M_finish - __n, _M_finish, _M_finish);
+    _M_finish += __n;
+    copy_backward(__position, __old_finish - __n, __old_finish);
+    copy(__first, __last, __position);
+  }
+  else {
+    uninitialized_copy(__first + __elems_after, __last, _M_finish);
+    _M_finish += __n - __elems_after;
+    uninitialized_copy(__position, __old_finish, _M_finish);
+    _M_finish += __elems_after;
+    copy(__first, __first + __elems_after, __position);
+  }
+}
+
+#endif /* __STL_MEMBER_TEMPLATES */
+
+// At least one side is inline.  An inline side fits in the other's
+// buffer only if that buffer is inline too or is the heap block it is
+// about to take over, so: heap block and inline elements trade places,
+// or two inline buffers swap their common prefix and the longer one
+// relocates its tail.
+template <class _Tp, size_t __N, class _Alloc>
+void
+small_vector<_Tp, __N, _Alloc>::_M_swap_inline(
+  small_vector<_Tp, __N, _Alloc>& __x)
+{
+  if (!_M_is_inline()) {
+    __x._M_swap_inline(*this);
+    return;
+  }
+  if (!__x._M_is_inline()) {//xڶϣԪذxû
+    iterator __heap_start = __x._M_start;
+    iterator __heap_finish = __x._M_finish;
+    iterator __heap_end = __x._M_end_of_storage;
+    iterator __x_finish =
+      __uninitialized_relocate(_M_start, _M_finish, __x._M_inline());
+    __x._M_start = __x._M_inline();
+    __x._M_finish = __x_finish;
+    __x._M_end_of_storage = __x._M_start + __N;
+    _M_start = __heap_start;
+    _M_finish = __heap_finish;
+    _M_end_of_storage = __heap_end;
+    return;
+  }
+  small_vector<_Tp, __N, _Alloc>* __long = this;
+  small_vector<_Tp, __N, _Alloc>* __short = &__x;
+  if (__long->size() < __short->size()) {
+    __long = &__x;
+    __short = this;
+  }
+  const size_type __common = __short->size();
+  swap_ranges(__short->_M_start, __short->_M_finish, __long->_M_start);
+  __short->_M_finish =
+    __uninitialized_relocate(__long->_M_start + __common, __long->_M_finish,
+                             __short->_M_finish);
+  __long->_M_finish = __long->_M_start + __common;
+}
+
+template <class _Tp, size_t __N, class _Alloc>
+small_vector<_Tp, __N, _Alloc>& 
+small_vector<_Tp, __N, _Alloc>::operator=(
+  const small_vector<_Tp, __N, _Alloc>& __x)
+{
+  if (&__x != this) {
+    const size_type __xlen = __x.size();
+    if (__xlen > capacity()) {
+      clear();
+      _M_grow(__xlen);
+      _M_finish = uninitialized_copy(__x.begin(), __x.end(), _M_start);
+    }
+    else if (size() >= __xlen) {
+      iterator __i = copy(__x.begin(), __x.end(), begin());
+      _Destroy_n(__i, _M_finish - __i);
+      _M_finish = __i;
+    }
+    else {
+      copy(__x.begin(), __x.begin() + size(), _M_start);
+      _M_finish = uninitialized_copy(__x.begin() + size(), __x.end(),
+                                     _M_finish);
+    }
+  }
+  return *this;
+}
+
+template <class _Tp, size_t __N, class _Alloc>
+inline bool 
+operator==(const small_vector<_Tp, __N, _Alloc>& __x,
+           const small_vector<_Tp, __N, _Alloc>& __y)
+{
+  return __x.size() == __y.size() &&
+         equal(__x.begin(), __x.end(), __y.begin());
+}
+
+template <class _Tp, size_t __N, class _Alloc>
+inline bool 
+operator<(const small_vector<_Tp, __N, _Alloc>& __x,
+          const small_vector<_Tp, __N, _Alloc>& __y)
+{
+  return lexicographical_compare(__x.begin(), __x.end(), 
+                                 __y.begin(), __y.end());
+}
+
+#ifdef __STL_FUNCTION_TMPL_PARTIAL_ORDER
+
+template <class _Tp, size_t __N, class _Alloc>
+inline void swap(small_vector<_Tp, __N, _Alloc>& __x,
+                 small_vector<_Tp, __N, _Alloc>& __y)
+{
+  __x.swap(__y);
+}
+
+template <class _Tp, size_t __N, class _Alloc>
+inline bool
+operator!=(const small_vector<_Tp, __N, _Alloc>& __x,
+           const small_vector<_Tp, __N, _Alloc>& __y) {
+  return !(__x == __y);
+}
+
+template <class _Tp, size_t __N, class _Alloc>
+inline bool
+operator>(const small_vector<_Tp, __N, _Alloc>& __x,
+          const small_vector<_Tp, __N, _Alloc>& __y) {
+  return __y < __x;
+}
+
+template <class _Tp, size_t __N, class _Alloc>
+inline bool
+operator<=(const small_vector<_Tp, __N, _Alloc>& __x,
+           const small_vector<_Tp, __N, _Alloc>& __y) {
+  return !(__y < __x);
+}
+
+template <class _Tp, size_t __N, class _Alloc>
+inline bool
+operator>=(const small_vector<_Tp, __N, _Alloc>& __x,
+           const small_vector<_Tp, __N, _Alloc>& __y) {
+  return !(__x < __y);
+}
+
+#endif /* __STL_FUNCTION_TMPL_PARTIAL_ORDER */
+
 #if defined(__sgi) && !defined(__GNUC__) && (_MIPS_SIM != _MIPS_SIM_ABI32)
 #pragma reset woff 1174
 #pragma reset woff 1375
@@ -103,6 +103,63 @@ inline void _Destroy(double*, double*) {}
 inline void _Destroy(wchar_t*, wchar_t*) {}
 #endif /* __STL_HAS_WCHAR_T */
 
+// Batch versions.  _Destroy_n destroys __n elements starting at
+// __first; like _Destroy it does nothing at all, not even walk the
+// iterator, when the value type has a trivial destructor.  _Construct_n
+// builds __n elements, default-constructed or copies of __value, and
+// returns the end of the new range.  If a constructor throws, what was
+// built is destroyed in one pass and the exception goes on.  Containers
+// whose iterators span several buffers (deque) overload both to work
+// one contiguous run at a time.
+
+template <class _ForwardIterator, class _Size>
+inline void _Destroy_n(_ForwardIterator __first, _Size __n) {
+  __destroy_n(__first, __n, __VALUE_TYPE(__first));
+}
+
+template <class _ForwardIterator, class _Size, class _Tp>
+inline void __destroy_n(_ForwardIterator __first, _Size __n, _Tp*)
+{
+  typedef typename __type_traits<_Tp>::has_trivial_destructor
+          _Trivial_destructor;
+  __destroy_n_aux(__first, __n, _Trivial_destructor());
+}
+
+template <class _ForwardIterator, class _Size>
+inline void __destroy_n_aux(_ForwardIterator, _Size, __true_type) {}
+
+template <class _ForwardIterator, class _Size>
+void __destroy_n_aux(_ForwardIterator __first, _Size __n, __false_type)
+{
+  for ( ; __n > 0; --__n, ++__first)
+    _Destroy(&*__first);
+}
+
+template <class _ForwardIterator, class _Size>
+_ForwardIterator _Construct_n(_ForwardIterator __first, _Size __n)
+{
+  _ForwardIterator __cur = __first;
+  __STL_TRY {
+    for ( ; __n > 0; --__n, ++__cur)
+      _Construct(&*__cur);//ĬϹ
+    return __cur;
+  }
+  __STL_UNWIND(_Destroy(__first, __cur));//һѹĲ
+}
+
+template <class _ForwardIterator, class _Size, class _Tp>
+_ForwardIterator
+_Construct_n(_ForwardIterator __first, _Size __n, const _Tp& __value)
+{
+  _ForwardIterator __cur = __first;
+  __STL_TRY {
+    for ( ; __n > 0; --__n, ++__cur)
+      _Construct(&*__cur, __value);
+    return __cur;
+  }
+  __STL_UNWIND(_Destroy(__first, __cur));
+}
+
 // --------------------------------------------------
 // Old names from the HP STL.
 
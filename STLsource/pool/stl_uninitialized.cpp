@@ -31,6 +31,22 @@
 #ifndef __SGI_STL_INTERNAL_UNINITIALIZED_H
 #define __SGI_STL_INTERNAL_UNINITIALIZED_H
 
+// Filling POD arrays uses SSE2 stores, or AVX2 stores when the CPU has
+// them, unless __STL_NO_SIMD_FILL is defined.
+#if defined(__GNUC__) && !defined(__STL_NO_SIMD_FILL) \
+    && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+# define __STL_SIMD_FILL
+# include <immintrin.h>
+#endif
+
+// Relocating a class that is not trivially relocatable moves each
+// element when the compiler has rvalue references, and copies it
+// otherwise.
+#if __cplusplus >= 201103L && !defined(__STL_NO_RVALUE_REFERENCES)
+# define __STL_RVALUE_REFERENCES
+# include <utility>
+#endif
+
 __STL_BEGIN_NAMESPACE
 
 // uninitialized_copy
@@ -89,6 +105,26 @@ __uninitialized_copy_aux(_InputIter __first, _InputIter __last,
 	*/
 	return copy(__first, __last, __result);
 }
+
+// POD arrays are copied with memcpy: the destination is raw storage,
+// so it cannot overlap the source.
+template <class _Tp>
+inline _Tp*
+__uninitialized_copy_aux(const _Tp* __first, const _Tp* __last,
+                         _Tp* __result, __true_type)
+{
+  memcpy(__result, __first, sizeof(_Tp) * (__last - __first));
+  return __result + (__last - __first);
+}
+
+template <class _Tp>
+inline _Tp*
+__uninitialized_copy_aux(_Tp* __first, _Tp* __last,
+                         _Tp* __result, __true_type)
+{
+  memcpy(__result, __first, sizeof(_Tp) * (__last - __first));
+  return __result + (__last - __first);
+}
 //char*wchar_t* uninitialized_copy()ػ汾
 inline char* uninitialized_copy(const char* __first, const char* __last,
                                 char* __result) {
@@ -110,6 +146,85 @@ uninitialized_copy(const wchar_t* __first, const wchar_t* __last,
 }
 
 
+// Fill kernels for POD arrays.  __fill_pattern writes __bytes bytes
+// at __dst by repeating the 16-byte __pat, which holds the value
+// repeated for elements of 1, 2, 4, 8 or 16 bytes.  __bytes is a whole
+// number of elements, so the pattern stays in phase with them.
+#ifdef __STL_SIMD_FILL
+
+__attribute__((__target__("avx2")))
+inline void __fill_pattern_avx2(char* __dst, size_t __bytes,
+                                const unsigned char* __pat)
+{
+  __m128i __half = _mm_loadu_si128((const __m128i*) __pat);
+  __m256i __v = _mm256_broadcastsi128_si256(__half);
+  for ( ; __bytes >= 128; __bytes -= 128, __dst += 128) {//ÿд128ֽ
+    _mm256_storeu_si256((__m256i*) __dst, __v);
+    _mm256_storeu_si256((__m256i*) (__dst + 32), __v);
+    _mm256_storeu_si256((__m256i*) (__dst + 64), __v);
+    _mm256_storeu_si256((__m256i*) (__dst + 96), __v);
+  }
+  for ( ; __bytes >= 16; __bytes -= 16, __dst += 16)
+    _mm_storeu_si128((__m128i*) __dst, __half);
+  memcpy(__dst, __pat, __bytes);//16ֽڵβ
+}
+
+inline void __fill_pattern_sse2(char* __dst, size_t __bytes,
+                                const unsigned char* __pat)
+{
+  __m128i __v = _mm_loadu_si128((const __m128i*) __pat);
+  for ( ; __bytes >= 64; __bytes -= 64, __dst += 64) {
+    _mm_storeu_si128((__m128i*) __dst, __v);
+    _mm_storeu_si128((__m128i*) (__dst + 16), __v);
+    _mm_storeu_si128((__m128i*) (__dst + 32), __v);
+    _mm_storeu_si128((__m128i*) (__dst + 48), __v);
+  }
+  for ( ; __bytes >= 16; __bytes -= 16, __dst += 16)
+    _mm_storeu_si128((__m128i*) __dst, __v);
+  memcpy(__dst, __pat, __bytes);
+}
+
+inline void __fill_pattern(char* __dst, size_t __bytes,
+                           const unsigned char* __pat)
+{
+  static int __has_avx2 = -1;//״εʱCPU
+  if (__has_avx2 < 0) {
+    __builtin_cpu_init();
+    __has_avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+  }
+  if (__has_avx2 && __bytes >= 256)
+    __fill_pattern_avx2(__dst, __bytes, __pat);
+  else
+    __fill_pattern_sse2(__dst, __bytes, __pat);
+}
+
+#endif /* __STL_SIMD_FILL */
+
+// Fills __n elements of a POD array.  Element sizes that divide 16 go
+// to the vector kernels once the array is long enough to pay for
+// building the pattern; everything else is a plain loop.
+template <class _Tp>
+inline void __uninitialized_fill_pod(_Tp* __first, size_t __n, const _Tp& __x)
+{
+  if (sizeof(_Tp) == 1) {
+    unsigned char __c;
+    memcpy(&__c, &__x, 1);
+    memset(__first, __c, __n);
+    return;
+  }
+#ifdef __STL_SIMD_FILL
+  if (16 % sizeof(_Tp) == 0 && __n * sizeof(_Tp) >= 64) {
+    unsigned char __pat[16];
+    for (size_t __i = 0; __i < 16; __i += sizeof(_Tp))
+      memcpy(__pat + __i, &__x, sizeof(_Tp));//ѳֵظ16ֽ
+    __fill_pattern((char*) __first, __n * sizeof(_Tp), __pat);
+    return;
+  }
+#endif /* __STL_SIMD_FILL */
+  for ( ; __n > 0; --__n, ++__first)
+    *__first = __x;
+}
+
 // Valid if copy construction is equivalent to assignment, and if the
 // destructor is trivial.
 template <class _ForwardIter, class _Tp>
@@ -125,6 +240,16 @@ __uninitialized_fill_aux(_ForwardIter __first, _ForwardIter __last,
 	fill(__first, __last, __x);
 }
 
+//POD飺亯
+template <class _Tp, class _Tp1>
+inline void
+__uninitialized_fill_aux(_Tp* __first, _Tp* __last,
+                         const _Tp1& __x, __true_type)
+{
+  _Tp __val = __x;
+  __uninitialized_fill_pod(__first, __last - __first, __val);
+}
+
 template <class _ForwardIter, class _Tp>
 /*PODͱô˺
 	*/
@@ -184,6 +309,18 @@ __uninitialized_fill_n_aux(_ForwardIter __first, _Size __n,
 	return fill_n(__first, __n, __x);
 }
 
+template <class _Tp, class _Size, class _Tp1>
+inline _Tp*
+__uninitialized_fill_n_aux(_Tp* __first, _Size __n,
+                           const _Tp1& __x, __true_type)
+{
+  if (__n <= 0)
+    return __first;
+  _Tp __val = __x;
+  __uninitialized_fill_pod(__first, (size_t) __n, __val);
+  return __first + __n;
+}
+
 template <class _ForwardIter, class _Size, class _Tp>
 _ForwardIter
 	/*PODͱô˺
@@ -226,6 +363,72 @@ uninitialized_fill_n(_ForwardIter __first, _Size __n, const _Tp& __x)
 }
 
 
+// Relocation: building objects in raw storage from existing ones and
+// ending the lifetime of the originals, as vector does when it grows.
+//
+// __relocate_traits<_Tp>::_Trivially_relocatable is __true_type if a _Tp
+// may be moved with memcpy and the original forgotten, without running
+// its destructor.  That holds for POD types, and for any class that
+// holds no pointer into itself; the SGI containers whose header lives
+// on the heap (vector, list, deque) specialize it.  Other classes may do
+// the same.
+template <class _Tp>
+struct __relocate_traits {
+  typedef typename __type_traits<_Tp>::is_POD_type _Trivially_relocatable;
+};
+
+// Builds [__result, __result + (__last - __first)) from [__first, __last)
+// and leaves the source alive.  With rvalue references each element is
+// moved, unless its move constructor may throw.  If an exception
+// escapes, nothing is left at __result and the source is unchanged.
+template <class _Tp>
+_Tp* __uninitialized_move(_Tp* __first, _Tp* __last, _Tp* __result)
+{
+#ifdef __STL_RVALUE_REFERENCES
+  _Tp* __cur = __result;
+  __STL_TRY {
+    for ( ; __first != __last; ++__first, ++__cur)
+      ::new(static_cast<void*>(__cur)) _Tp(std::move_if_noexcept(*__first));
+    return __cur;
+  }
+  __STL_UNWIND(_Destroy(__result, __cur));
+#else
+  return uninitialized_copy(__first, __last, __result);
+#endif /* __STL_RVALUE_REFERENCES */
+}
+
+template <class _Tp>
+inline _Tp*
+__uninitialized_relocate_aux(_Tp* __first, _Tp* __last, _Tp* __result,
+                             __true_type)
+{
+  //ֽڰƣԴ
+  ptrdiff_t __n = __last - __first;
+  if (__n > 0)
+    memcpy((void*)__result, (const void*)__first, __n * sizeof(_Tp));
+  return __result + __n;
+}
+
+template <class _Tp>
+inline _Tp*
+__uninitialized_relocate_aux(_Tp* __first, _Tp* __last, _Tp* __result,
+                             __false_type)
+{
+  _Tp* __cur = __uninitialized_move(__first, __last, __result);
+  _Destroy(__first, __last);
+  return __cur;
+}
+
+// Relocates [__first, __last) to raw storage at __result.  On return
+// the source holds no live objects.  If an exception escapes, the source
+// is unchanged.
+template <class _Tp>
+inline _Tp*
+__uninitialized_relocate(_Tp* __first, _Tp* __last, _Tp* __result)
+{
+  typedef typename __relocate_traits<_Tp>::_Trivially_relocatable _Trivial;
+  return __uninitialized_relocate_aux(__first, __last, __result, _Trivial());
+}
 
 __STL_END_NAMESPACE
 